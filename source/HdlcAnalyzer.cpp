@@ -1,5 +1,7 @@
 #include "HdlcAnalyzer.h"
 #include "HdlcAnalyzerSettings.h"
+#include "HdlcCrc.h"
+#include "HdlcCrcModel.h"
 #include <AnalyzerChannelData.h>
 #include <AnalyzerHelpers.h>
 #include <iostream>
@@ -7,6 +9,21 @@
 
 using namespace std;
 
+// Bit of the stop bit in a start/stop character (bit 0 is the start bit)
+#define HDLC_ASYNC_STOP_BIT 9
+// The results are committed at least every 50 ms or 1024 HDLC frames
+#define HDLC_COMMIT_MAX_FRAMES 1024
+#define HDLC_COMMIT_MAX_MILLISECONDS 50
+// Progress and cancellation are checked at least every 16384 bit periods inside a frame or
+// while hunting for flags
+#define HDLC_CHECKPOINT_BITS 16384
+// Bytes of a field of the compact information field
+#define HDLC_INFORMATION_CHUNK_BYTES 64
+// Fields held between two repeated frames (fill flags) before the repeats are shown
+#define HDLC_REPEAT_MAX_HELD_FIELDS 1024
+// Bytes of an extended address that fit in the address compared by the frame filter
+#define HDLC_FILTER_ADDRESS_MAX_BYTES 8
+
 HdlcAnalyzer::HdlcAnalyzer()
 :	Analyzer(),  
 	mSettings( new HdlcAnalyzerSettings() ),
@@ -32,6 +49,19 @@ void HdlcAnalyzer::SetupAnalyzer()
 	mSamplesInHalfPeriod = U64( ( mSampleRateHz * halfPeriod ) / 1000000.0 );
 	mSamplesInAFlag = mSamplesInHalfPeriod * 7;
 	mSamplesIn8Bits = mSamplesInHalfPeriod * 8;
+	mAsyncSamplesPerBit = ( U64( mSampleRateHz ) << 16 ) / mSettings->mBitRate;
+	mCheckpointSamples = mSamplesInHalfPeriod * HDLC_CHECKPOINT_BITS;
+	mNextCheckpointSample = 0;
+	mNextEdgeSample = 0;
+	mBitSyncDecoder.Setup( mHdlc, mSampleRateHz, mSettings->mBitRate, 
+						   mSettings->mBitSyncDecoder == HDLC_BIT_SYNC_DECODER_DPLL );
+	mFcsBytes = HdlcCrc::FcsBytes( mSettings->mHdlcFcs );
+	if( mSettings->mLocateBitErrors )
+	{
+		mSyndromeTable.Build( mSettings->mHdlcFcs );
+		// All the bytes kept by AddByteToFrameCrc: no allocation while decoding
+		mFrameBitSamples.reserve( mSyndromeTable.GetMaxBits() + 8 );
+	}
 	
 	mPreviousBitState = mHdlc->GetBitState();
 	mConsecutiveOnes = 0;
@@ -40,62 +70,75 @@ void HdlcAnalyzer::SetupAnalyzer()
 	mCurrentFrameIsSFrame = false;
   mLastFrameEndSample = 0;
   mFoundEndFlag = false;
+	mHasInformationChunk = false;
+	mFrameFilterState = HDLC_FRAME_FILTER_PASS;
+	mFilterPending = false;
+	mFrameMayRepeat = false;
+	mHasRepeatCandidate = false;
+	mRepeatCount = 0;
+	if( mSettings->FilterFrames() || mSettings->mCollapseRepeatedFrames )
+	{
+		// The vectors keep their size from frame to frame
+		mStagedFrames.reserve( 256 );
+		mStagedMarkers.reserve( 256 );
+		mHeldFrames.reserve( HDLC_REPEAT_MAX_HELD_FIELDS );
+	}
 	
+	SelectFrameDecoder();
 }
 
-bool HdlcAnalyzer::FrameComparison(const Frame & frame0, const Frame & frame1)
+// The frame decoder is instantiated for every byte reader and FCS type, so the reader, the CRC
+// update and the FCS length are resolved at compile time for every byte. The settings that are
+// only looked at once per frame (address, control and HCS fields) are left to run time.
+void HdlcAnalyzer::SelectFrameDecoder()
 {
-  return frame0.mStartingSampleInclusive < frame1.mStartingSampleInclusive;
+	if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BYTE_ASYNC )
+	{
+		mProcessFrame = FrameDecoderFor< HDLC_READER_BYTE_ASYNC >( mSettings->mHdlcFcs );
+	}
+	else if( UseBitSyncEdgeDecoder() )
+	{
+		mProcessFrame = FrameDecoderFor< HDLC_READER_BIT_SYNC_EDGES >( mSettings->mHdlcFcs );
+	}
+	else
+	{
+		mProcessFrame = FrameDecoderFor< HDLC_READER_BIT_SYNC_SAMPLING >( mSettings->mHdlcFcs );
+	}
 }
 
-void HdlcAnalyzer::CommitFrames()
+template< HdlcByteReaderType Reader >
+HdlcAnalyzer::FrameDecoder HdlcAnalyzer::FrameDecoderFor( HdlcFcsType fcsType ) const
 {
-
-  if(mResultFrames.empty())
-  {
-    return;
-  }
-  
-  // Commit the First Frame
-  Frame lastFrame = mResultFrames.at( 0 );
-  mResults->AddFrame( lastFrame );
-
-  // Commit the rest of the frames avoiding overlapping sample endpoints
-  for(U32 i=1; i < mResultFrames.size(); ++i)
-  {
-    Frame frame = mResultFrames.at(i);
-    if( frame.mStartingSampleInclusive < lastFrame.mEndingSampleInclusive )
-    {
-      frame.mStartingSampleInclusive += lastFrame.mEndingSampleInclusive - frame.mStartingSampleInclusive + 1;
-    }
-    mResults->AddFrame( frame );
-    lastFrame = frame;
-  }
+	switch( fcsType )
+	{
+		case HDLC_CRC8: return &HdlcAnalyzer::ProcessHDLCFrame< Reader, HDLC_CRC8 >;
+		case HDLC_CRC32: return &HdlcAnalyzer::ProcessHDLCFrame< Reader, HDLC_CRC32 >;
+		case HDLC_FCS16: return &HdlcAnalyzer::ProcessHDLCFrame< Reader, HDLC_FCS16 >;
+		case HDLC_FCS32: return &HdlcAnalyzer::ProcessHDLCFrame< Reader, HDLC_FCS32 >;
+		case HDLC_CRC16: default: return &HdlcAnalyzer::ProcessHDLCFrame< Reader, HDLC_CRC16 >;
+	}
 }
 
 void HdlcAnalyzer::WorkerThread()
 {
 	SetupAnalyzer();
 	
-	if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BIT_SYNC )
+	if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BIT_SYNC && !UseBitSyncEdgeDecoder() )
 	{
 		// Synchronize
 		mHdlc->AdvanceToNextEdge();
 	}
 	
 	// Main loop
+	mCommitScheduler.Reset( HDLC_COMMIT_MAX_FRAMES, HDLC_COMMIT_MAX_MILLISECONDS );
 	for( ; ; )
 	{
-		ProcessHDLCFrame();
-
-    // Sort and commit the frames of the HDLC Frame
-    sort(mResultFrames.begin(), mResultFrames.end(), FrameComparison);
-    CommitFrames();
-    mResultFrames.clear();
+		( this->*mProcessFrame )();
     
-		mResults->CommitResults();
-		ReportProgress( mHdlc->GetSampleNumber() );
-		CheckIfThreadShouldExit();
+		if( mCommitScheduler.FrameDone() )
+		{
+			CommitResults();
+		}
     
 	}
 	
@@ -105,25 +148,114 @@ void HdlcAnalyzer::WorkerThread()
 /////////////// SYNC BIT TRAMISSION ///////////////////////////////////////////////
 //
 
+void HdlcAnalyzer::CommitResults()
+{
+	mResults->CommitResults();
+	U64 sample = mHdlc->GetSampleNumber();
+	ReportProgress( sample );
+	CheckIfThreadShouldExit();
+	mCommitScheduler.Committed();
+	mNextCheckpointSample = sample + mCheckpointSamples;
+}
+
+// Called once per byte or flag in the loops that can last for long (a long frame or a long
+// hunt for flags): the progress is reported and the thread can be stopped every
+// HDLC_CHECKPOINT_BITS, so the cost is a comparison per byte. The results are committed there
+// too when the time limit is reached, since a corrupted stream may never end a frame.
+void HdlcAnalyzer::Checkpoint( U64 sample )
+{
+	if( mCommitScheduler.ByteDone() )
+	{
+		CommitResults();
+		return;
+	}
+	if( sample < mNextCheckpointSample )
+	{
+		return;
+	}
+	mNextCheckpointSample = sample + mCheckpointSamples;
+	ReportProgress( sample );
+	CheckIfThreadShouldExit();
+}
+
+bool HdlcAnalyzer::HasPendingResults() const
+{
+	return mCommitScheduler.HasPendingResults() || mRepeatCount > 0 || !mHeldFrames.empty();
+}
+
+void HdlcAnalyzer::CommitPendingResults()
+{
+	if( HasPendingResults() )
+	{
+		// The repeats so far are shown, the next ones are counted in a new field
+		EndRepeatRun();
+		CommitResults();
+	}
+}
+
+// Called before reading the next edge: if there are no more transitions, the read has to wait for
+// the capture (or there is nothing left to read), so the frames decoded so far are committed
+void HdlcAnalyzer::CommitIfWaitingForData()
+{
+	if( HasPendingResults() && !mHdlc->DoMoreTransitionsExistInCurrentData() )
+	{
+		CommitPendingResults();
+	}
+}
+
+// Sample of the next edge after sample (the current position). The data is known to reach the
+// edge looked up last, so the channel is only asked again once the position gets to it.
+U64 HdlcAnalyzer::SampleOfNextEdge( U64 sample )
+{
+	if( sample >= mNextEdgeSample )
+	{
+		CommitIfWaitingForData();
+		mNextEdgeSample = mHdlc->GetSampleOfNextEdge();
+	}
+	return mNextEdgeSample;
+}
+
+// Same as WouldAdvancingToAbsPositionCauseTransition( end ) from sample (the current position),
+// without looking past the next edge: a window past the last edge can go past the end of the
+// data, so it's only read when there are no more edges, after committing the pending results
+bool HdlcAnalyzer::EdgeComing( U64 sample, U64 end )
+{
+	if( sample >= mNextEdgeSample )
+	{
+		if( !mHdlc->DoMoreTransitionsExistInCurrentData() )
+		{
+			CommitPendingResults();
+			return mHdlc->WouldAdvancingToAbsPositionCauseTransition( end );
+		}
+		mNextEdgeSample = mHdlc->GetSampleOfNextEdge();
+	}
+	return mNextEdgeSample <= end;
+}
+
+template< HdlcByteReaderType Reader, HdlcFcsType Fcs >
 void HdlcAnalyzer::ProcessHDLCFrame()
 {
-	mCurrentFrameBytes.clear();
-	mCurrentFrameBytesForHCS.clear();
+	ResetFrameCrc();
 	
-	HdlcByte addressByte = ProcessFlags();
+	HdlcByte addressByte = ProcessFlags< Reader, Fcs >();
 	
-	ProcessAddressField( addressByte );
-	ProcessControlField();
-	mCurrentFrameBytesForHCS = mCurrentFrameBytes;
-	ProcessInfoAndFcsField();
+	ProcessAddressField< Reader, Fcs >( addressByte );
+	ProcessControlField< Reader, Fcs >();
+	FilterFrameHeader();
+	SnapshotHeaderCrc();
+	ProcessInfoAndFcsField< Reader, Fcs >();
 	
 	if( mAbortFrame ) // The frame has been aborted at some point
 	{
-    mResults->AddMarker( mHdlc->GetSampleNumber(), AnalyzerResults::ErrorX, mSettings->mInputChannel );
+		// The edge decoder is already past the abort sequence
+		U64 abortSample = ( Reader == HDLC_READER_BIT_SYNC_EDGES ) 
+						  ? mAbortFrameToEmit.mEndingSampleInclusive : mHdlc->GetSampleNumber();
+		AddMarkerToResults( abortSample, AnalyzerResults::ErrorX );
 		AddFrameToResults( mAbortFrameToEmit );
-		if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BIT_SYNC )
+		if( Reader == HDLC_READER_BIT_SYNC_SAMPLING )
 		{
 			// After abortion, synchronize again
+			CommitIfWaitingForData();
 			mHdlc->AdvanceToNextEdge();
 		}
 	}
@@ -131,25 +263,34 @@ void HdlcAnalyzer::ProcessHDLCFrame()
 	{
 		AddFrameToResults( mEndFlagFrameToEmit );
 	}
+	EndFrameFilter();
 	
 	mReadingFrame = false;
 	mAbortFrame = false;
 	mCurrentFrameIsSFrame = false;	
 }
 
+template< HdlcByteReaderType Reader, HdlcFcsType Fcs >
 HdlcByte HdlcAnalyzer::ProcessFlags()
 {
 	HdlcByte addressByte;
-	if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BIT_SYNC ) 
+	if( Reader != HDLC_READER_BYTE_ASYNC ) 
 	{
-		BitSyncProcessFlags();
+		if( Reader == HDLC_READER_BIT_SYNC_EDGES )
+		{
+			BitSyncEdgeProcessFlags();
+		}
+		else
+		{
+			BitSyncProcessFlags();
+		}
 		mReadingFrame = true;
-		addressByte = ReadByte();
+		addressByte = ReadByte< Reader, Fcs >();
 	}
 	else 
 	{
 		mReadingFrame = true;
-		addressByte = ByteAsyncProcessFlags();
+		addressByte = ByteAsyncProcessFlags< Fcs >();
 	}
 	
 	return addressByte;
@@ -159,26 +300,25 @@ HdlcByte HdlcAnalyzer::ProcessFlags()
 void HdlcAnalyzer::BitSyncProcessFlags()
 {
 	bool flagEncountered = false;
-	vector<HdlcByte> flags;
+	ResetFlagRun();
 	for( ; ; )
 	{
+		// The time to the next edge tells an idle line (or abort), a flag or other bits at once
+		// (SamplesToNextEdge(), with the position kept for the checkpoint)
+		U64 sample = mHdlc->GetSampleNumber();
+		U64 samplesToNextEdge = SampleOfNextEdge( sample ) - sample;
+		Checkpoint( sample );
 		
-		if( AbortComing() )
+		if( AbortComing( samplesToNextEdge ) )
 		{
 			// Show fill flags
-			for( U32 i=0; i < flags.size(); ++i )
-			{	
-				Frame frame = CreateFrame( HDLC_FIELD_FLAG, flags.at(i).startSample, 
-										flags.at(i).endSample, HDLC_FLAG_FILL );
-				AddFrameToResults( frame );
-			}
-			flags.clear();
+			EmitFlagRun( false );
 			mHdlc->AdvanceToNextEdge();
 			flagEncountered = false;
 			continue;
 		}
 		
-		if( FlagComing() )
+		if( FlagComing( samplesToNextEdge ) )
 		{
 			HdlcByte bs;
 			bs.value = 0;
@@ -187,11 +327,11 @@ void HdlcAnalyzer::BitSyncProcessFlags()
 			mHdlc->AdvanceToNextEdge();
 			bs.endSample = mHdlc->GetSampleNumber();
 			
-			flags.push_back(bs);
+			AddFlagToRun( bs );
 			
       if( !mSettings->mSharedZero )
       {
-        if( mHdlc->WouldAdvancingCauseTransition( mSamplesInHalfPeriod * 1.5 ) )
+        if( EdgeComing( bs.endSample, bs.endSample + U32( mSamplesInHalfPeriod * 1.5 ) ) )
         {
           mHdlc->Advance( mSamplesInHalfPeriod * 0.5 );
           mPreviousBitState = mHdlc->GetBitState();
@@ -227,24 +367,16 @@ void HdlcAnalyzer::BitSyncProcessFlags()
 		}
 	}
 	
-	for( U32 i=0; i < flags.size(); ++i )
-	{
-		Frame frame = CreateFrame( HDLC_FIELD_FLAG, flags.at(i).startSample, 
-								  flags.at(i).endSample, HDLC_FLAG_FILL );
-		if( i == flags.size() - 1 )
-		{
-			frame.mData1 = HDLC_FLAG_START;
-		}
-		AddFrameToResults( frame );
-	}
+	EmitFlagRun( true );
 	
 }
 
-// Read bit with bit-stuffing
-BitState HdlcAnalyzer::BitSyncReadBit()
+// Read bit with bit-stuffing. The pending results are committed once per byte, by BitSyncReadByte.
+BitState HdlcAnalyzer::BitSyncReadBit( U64 & bitSample )
 {
   // Re-sync
-  if( mHdlc->GetSampleOfNextEdge() < mHdlc->GetSampleNumber() + mSamplesInHalfPeriod * 0.20 )
+  U64 sample = mHdlc->GetSampleNumber();
+  if( SampleOfNextEdge( sample ) < sample + mSamplesInHalfPeriod * 0.20 )
   {
     mHdlc->AdvanceToNextEdge();
   }
@@ -253,6 +385,7 @@ BitState HdlcAnalyzer::BitSyncReadBit()
   
   mHdlc->Advance( mSamplesInHalfPeriod * 0.5 );
 	BitState bit = mHdlc->GetBitState(); // sample the bit
+	bitSample = mHdlc->GetSampleNumber();
 	
 	if( bit == mPreviousBitState )
 	{
@@ -262,12 +395,12 @@ BitState HdlcAnalyzer::BitSyncReadBit()
 			U64 currentPos = mHdlc->GetSampleNumber();
 			
 			// Check for 0-bit insertion (i.e. line toggle)
-			if( mHdlc->GetSampleOfNextEdge() < currentPos + mSamplesInHalfPeriod )
+			if( SampleOfNextEdge( currentPos ) < currentPos + mSamplesInHalfPeriod )
 			{
 				// Advance to the next edge to re-synchronize the analyzer
 				mHdlc->AdvanceToNextEdge();
 				// Mark the bit-stuffing
-				mResults->AddMarker( mHdlc->GetSampleNumber() , AnalyzerResults::Dot, mSettings->mInputChannel );
+				AddStuffedBit( mHdlc->GetSampleNumber() );
 				mHdlc->Advance( mSamplesInHalfPeriod * 0.5 );
 				
 				mPreviousBitState = mHdlc->GetBitState();
@@ -275,6 +408,9 @@ BitState HdlcAnalyzer::BitSyncReadBit()
 			}
 			else // Abort!
 			{
+				// The abort sequence goes from the first of the ones to the seventh
+				U64 startSample = currentPos - U64( mSamplesInHalfPeriod * 4.5 );
+				mAbortFrameToEmit = CreateFrame( HDLC_ABORT_SEQ, startSample, startSample + mSamplesInHalfPeriod * 7 );
 				mConsecutiveOnes = 0;
 				mAbortFrame = true;				
 			}
@@ -297,7 +433,8 @@ BitState HdlcAnalyzer::BitSyncReadBit()
 	mHdlc->Advance( mSamplesInHalfPeriod * 0.5 );
   
 	// Re-sync
-  if( mHdlc->GetSampleOfNextEdge() < mHdlc->GetSampleNumber() + mSamplesInHalfPeriod * 0.20 )
+  sample = mHdlc->GetSampleNumber();
+  if( SampleOfNextEdge( sample ) < sample + mSamplesInHalfPeriod * 0.20 )
   {
     mHdlc->AdvanceToNextEdge();
   }
@@ -305,20 +442,30 @@ BitState HdlcAnalyzer::BitSyncReadBit()
 	return ret;
 }
 
-bool HdlcAnalyzer::FlagComing()
+// Same as WouldAdvancingCauseTransition( n ) == ( samplesToNextEdge <= n ), with a single lookahead
+U64 HdlcAnalyzer::SamplesToNextEdge()
 {
-	return !mHdlc->WouldAdvancingCauseTransition( mSamplesInAFlag - mSamplesInHalfPeriod  * 0.5 ) &&
-		   mHdlc->WouldAdvancingCauseTransition( mSamplesInAFlag + mSamplesInHalfPeriod * 0.5 );
+	U64 sample = mHdlc->GetSampleNumber();
+	return SampleOfNextEdge( sample ) - sample;
 }
 
-bool HdlcAnalyzer::AbortComing()
+bool HdlcAnalyzer::FlagComing( U64 samplesToNextEdge ) const
 {
-	return !mHdlc->WouldAdvancingCauseTransition( mSamplesInAFlag + mSamplesInHalfPeriod * 0.5 );
+	return samplesToNextEdge > U32( mSamplesInAFlag - mSamplesInHalfPeriod * 0.5 ) &&
+		   samplesToNextEdge <= U32( mSamplesInAFlag + mSamplesInHalfPeriod * 0.5 );
 }
 
+bool HdlcAnalyzer::AbortComing( U64 samplesToNextEdge ) const
+{
+	return samplesToNextEdge > U32( mSamplesInAFlag + mSamplesInHalfPeriod * 0.5 );
+}
+
+template< HdlcFcsType Fcs >
 HdlcByte HdlcAnalyzer::BitSyncReadByte()
 {
-	if( mReadingFrame && AbortComing() )
+	U64 samplesToNextEdge = mReadingFrame ? SamplesToNextEdge() : 0;
+	
+	if( mReadingFrame && AbortComing( samplesToNextEdge ) )
 	{
 			// Create "Abort Frame" frame
 			U64 startSample = mHdlc->GetSampleNumber();
@@ -331,7 +478,7 @@ HdlcByte HdlcAnalyzer::BitSyncReadByte()
 			return HdlcByte();
 	}
 	
-	if( mReadingFrame && FlagComing() )
+	if( mReadingFrame && FlagComing( samplesToNextEdge ) )
 	{
 		U64 startSample = mHdlc->GetSampleNumber();
 		mHdlc->AdvanceToNextEdge();
@@ -347,78 +494,225 @@ HdlcByte HdlcAnalyzer::BitSyncReadByte()
 	U64 startSample = mHdlc->GetSampleNumber();
 	for( U32 i=0; i < 8 ; ++i )
 	{
-		BitState bit = BitSyncReadBit(); if( mAbortFrame ) { return HdlcByte(); }
+		BitState bit = BitSyncReadBit( mByteBitSamples[ i ] ); if( mAbortFrame ) { return HdlcByte(); }
 		dbyte.AddBit( bit );
 	}
 	U64 endSample = mHdlc->GetSampleNumber() - mSamplesInHalfPeriod;
 	HdlcByte bs = { startSample, endSample, U8( byteValue ), false };
-	mCurrentFrameBytes.push_back( bs.value );
+	AddByteToFrameCrc< Fcs >( bs.value );
 	return bs;
 }
 
+//
+/////////////// SYNC BIT TRAMISSION - EDGE INTERVAL DECODER ///////////////////////////
+//
+
+bool HdlcAnalyzer::UseBitSyncEdgeDecoder() const
+{
+	return mSettings->mBitSyncDecoder == HDLC_BIT_SYNC_DECODER_EDGES || 
+		   mSettings->mBitSyncDecoder == HDLC_BIT_SYNC_DECODER_DPLL;
+}
+
+HdlcBitSyncItem HdlcAnalyzer::NextBitSyncItem()
+{
+	while( mBitSyncDecoder.NeedsEdge() )
+	{
+		CommitIfWaitingForData();
+		mBitSyncDecoder.ReadInterval();
+	}
+	return mBitSyncDecoder.Next();
+}
+
+// Same as BitSyncProcessFlags: flags (shared zero or not) until the first bit of a frame
+void HdlcAnalyzer::BitSyncEdgeProcessFlags()
+{
+	ResetFlagRun();
+	for( ; ; )
+	{
+		HdlcBitSyncItem item = NextBitSyncItem();
+		Checkpoint( item.endSample );
+		
+		if( item.type == HDLC_BIT_SYNC_FLAG )
+		{
+			HdlcByte bs = { item.startSample, item.endSample, HDLC_FLAG_VALUE, false };
+			AddFlagToRun( bs );
+		}
+		else if( item.type == HDLC_BIT_SYNC_ABORT ) // idle line: the flags were fill flags
+		{
+			EmitFlagRun( false );
+		}
+		else if( item.type == HDLC_BIT_SYNC_DATA_BIT && mHasLastFlag ) // first bit of the frame
+		{
+			mBitSyncDecoder.Unread( item );
+			break;
+		}
+		// bits before a flag are ignored
+	}
+	
+	EmitFlagRun( true );
+}
+
+template< HdlcFcsType Fcs >
+HdlcByte HdlcAnalyzer::BitSyncEdgeReadByte()
+{
+	U8 value = 0;
+	U32 bits = 0;
+	U64 startSample = 0;
+	for( ; ; )
+	{
+		HdlcBitSyncItem item = NextBitSyncItem();
+		switch( item.type )
+		{
+			case HDLC_BIT_SYNC_FLAG:
+			{
+				// End of the frame (the bits of an incomplete byte before the flag are dropped)
+				mFoundEndFlag = true;
+				HdlcByte bs = { item.startSample, item.endSample, HDLC_FLAG_VALUE, false };
+				return bs;
+			}
+			case HDLC_BIT_SYNC_ABORT:
+			{
+				mAbortFrameToEmit = CreateFrame( HDLC_ABORT_SEQ, item.startSample, item.endSample );
+				mAbortFrame = true;
+				return HdlcByte();
+			}
+			case HDLC_BIT_SYNC_STUFFED_BIT:
+			{
+				// Mark the bit-stuffing
+				AddStuffedBit( item.startSample );
+				break;
+			}
+			case HDLC_BIT_SYNC_DATA_BIT:
+			{
+				if( bits == 0 )
+				{
+					startSample = item.startSample;
+				}
+				if( item.bit == BIT_HIGH )
+				{
+					value |= 1 << bits; // lsb first
+				}
+				mByteBitSamples[ bits ] = ( item.startSample + item.endSample ) / 2;
+				if( ++bits == 8 )
+				{
+					// Same as the bit sampling decoder: the byte ends at the start of its last bit
+					HdlcByte bs = { startSample, item.startSample, value, false };
+					AddByteToFrameCrc< Fcs >( bs.value );
+					return bs;
+				}
+				break;
+			}
+		}
+	}
+}
+
 //
 /////////////// ASYNC BYTE TRAMISSION ///////////////////////////////////////////////
 //
 
 // Interframe time fill: ISO/IEC 13239:2002(E) pag. 21
+template< HdlcFcsType Fcs >
 HdlcByte HdlcAnalyzer::ByteAsyncProcessFlags()
 {
-	bool flagEncountered = false;
 	// Read bytes until non-flag byte
-	vector<HdlcByte> readBytes;
+	ResetFlagRun();
 	
 	mCurrentField = ( mSettings->mHdlcAddr == HDLC_BASIC_ADDRESS_FIELD ) 
 					? HDLC_FIELD_BASIC_ADDRESS : HDLC_FIELD_EXTENDED_ADDRESS;
 	for( ; ; )
 	{
-		HdlcByte asyncByte = ReadByte(); 
-		if( asyncByte.value != HDLC_FLAG_VALUE && flagEncountered )
+		HdlcByte asyncByte = ByteAsyncReadByte< Fcs >(); 
+		Checkpoint( asyncByte.endSample );
+		if( mAbortFrame ) 
+		{ 
+			// The last flag before the abort sequence is shown as a start flag
+			EmitFlagRun( true );
+			return HdlcByte(); 
+		}
+		if( asyncByte.value != HDLC_FLAG_VALUE && mHasLastFlag )
 		{
-			readBytes.push_back( asyncByte );
-			break;
+			// Generate the flag frames and return non-flag byte after the flags
+			EmitFlagRun( true );
+			return asyncByte;
 		}
 		else if( asyncByte.value == HDLC_FLAG_VALUE ) 
 		{
-			readBytes.push_back( asyncByte );
-			flagEncountered = true;
-		}
-		if( mAbortFrame ) 
-		{ 
-			GenerateFlagsFrames( readBytes );
-			return HdlcByte(); 
+			AddFlagToRun( asyncByte );
+			// Bytes before the flag don't belong to the frame
+			ResetFrameCrc();
 		}
+	}
+}
+
+// The flags read while hunting for a frame are kept as a run: only the last flag (the start flag
+// if a frame follows) and the fill flags before it, counted if they are collapsed or else emitted
+// as soon as they are known to be fill flags
+void HdlcAnalyzer::ResetFlagRun()
+{
+	mFillFlags = 0;
+	mFillFlagsStart = 0;
+	mFillFlagsEnd = 0;
+	mHasLastFlag = false;
+}
 
+void HdlcAnalyzer::AddFlagToRun( const HdlcByte & flag )
+{
+	if( mHasLastFlag )
+	{
+		AddFillFlag( mLastFlag );
 	}
-	
-	GenerateFlagsFrames( readBytes );
-	
-	HdlcByte nonFlagByte = readBytes.back();
-	return nonFlagByte;
-	
+	mLastFlag = flag;
+	mHasLastFlag = true;
 }
 
-void HdlcAnalyzer::GenerateFlagsFrames( vector<HdlcByte> readBytes ) 
+void HdlcAnalyzer::AddFillFlag( const HdlcByte & flag )
 {
-	// 2) Generate the flag frames and return non-flag byte after the flags
-	for( U32 i=0; i<readBytes.size()-1; ++i )
+	if( !mSettings->mCollapseFillFlags )
 	{
-		HdlcByte asyncByte = readBytes[ i ];
-		
-		Frame frame = CreateFrame( HDLC_FIELD_FLAG, asyncByte.startSample, asyncByte.endSample );
-		
-		if( i==readBytes.size() - 2 ) // start flag
-		{
-			frame.mData1 = HDLC_FLAG_START;
-		}
-		else // fill flag
-		{
-			frame.mData1 = HDLC_FLAG_FILL;
-		}
-		
+		Frame frame = CreateFrame( HDLC_FIELD_FLAG, flag.startSample, flag.endSample, HDLC_FLAG_FILL );
 		AddFrameToResults( frame );
-	}	
+		return;
+	}
+	if( mFillFlags == 0 )
+	{
+		mFillFlagsStart = flag.startSample;
+	}
+	mFillFlagsEnd = flag.endSample;
+	mFillFlags++;
+}
+
+// Emits the pending flags: one field for all the fill flags (with their number in mData2) when
+// they are collapsed, and the last flag as the start flag or as one more fill flag
+void HdlcAnalyzer::EmitFlagRun( bool startFlag )
+{
+	if( mHasLastFlag && !startFlag )
+	{
+		AddFillFlag( mLastFlag );
+		mHasLastFlag = false;
+	}
+	
+	if( mFillFlags > 0 )
+	{
+		Frame frame = CreateFrame( HDLC_FIELD_FLAG, mFillFlagsStart, mFillFlagsEnd, HDLC_FLAG_FILL, mFillFlags );
+		AddFrameToResults( frame );
+		mFillFlags = 0;
+	}
+	
+	if( startFlag )
+	{
+		// The fields of the frame start with its start flag
+		BeginFrameFilter();
+	}
+	
+	if( mHasLastFlag )
+	{
+		Frame frame = CreateFrame( HDLC_FIELD_FLAG, mLastFlag.startSample, mLastFlag.endSample, HDLC_FLAG_START );
+		AddFrameToResults( frame );
+		mHasLastFlag = false;
+	}
 }
 
+template< HdlcByteReaderType Reader, HdlcFcsType Fcs >
 void HdlcAnalyzer::ProcessAddressField( HdlcByte byteAfterFlag )
 {
 	if( mAbortFrame )
@@ -434,7 +728,10 @@ void HdlcAnalyzer::ProcessAddressField( HdlcByte byteAfterFlag )
 		AddFrameToResults( frame );
 		
 		// Put a marker in the beggining of the HDLC frame
-		mResults->AddMarker( byteAfterFlag.startSample, AnalyzerResults::Start, mSettings->mInputChannel );
+		AddMarkerToResults( byteAfterFlag.startSample, AnalyzerResults::Start );
+		
+		mFrameAddress = byteAfterFlag.escaped ? HdlcAnalyzerSettings::Bit5Inv( byteAfterFlag.value ) : byteAfterFlag.value;
+		mFrameAddressKnown = true;
 		
 	}
 	else // HDLC_EXTENDED_ADDRESS_FIELD
@@ -442,27 +739,37 @@ void HdlcAnalyzer::ProcessAddressField( HdlcByte byteAfterFlag )
 		int i=0;
 		HdlcByte addressByte = byteAfterFlag;
 		// Put a marker in the beggining of the HDLC frame
-		mResults->AddMarker( addressByte.startSample, AnalyzerResults::Start, mSettings->mInputChannel );
+		AddMarkerToResults( addressByte.startSample, AnalyzerResults::Start );
 		for( ; ; ) 
 		{
 			U8 flag = ( addressByte.escaped ) ? HDLC_ESCAPED_BYTE : 0;
 			Frame frame = CreateFrame( HDLC_FIELD_EXTENDED_ADDRESS, addressByte.startSample, 
 									  addressByte.endSample, addressByte.value, i++, flag );
 			AddFrameToResults( frame );
+			
+			// A longer address doesn't fit: it is left unknown, so it matches no filter address
+			U8 address = addressByte.escaped ? HdlcAnalyzerSettings::Bit5Inv( addressByte.value ) : addressByte.value;
+			if( i <= HDLC_FILTER_ADDRESS_MAX_BYTES )
+			{
+				mFrameAddress = ( mFrameAddress << 8 ) | address;
+			}
 
 			U8 lsbBit = addressByte.value & 0x01;
 			if( !lsbBit ) // End of Extended Address Field?
 			{
+				mFrameAddressKnown = ( i <= HDLC_FILTER_ADDRESS_MAX_BYTES );
 				return;
 			}
 			
 			// Next address byte
-			addressByte = ReadByte(); if( mAbortFrame ) { return; }
+			addressByte = ReadByte< Reader, Fcs >(); if( mAbortFrame || FrameOversize( addressByte ) ) { return; }
+			Checkpoint( addressByte.endSample );
 			
 		}
 	}
 }
 
+template< HdlcByteReaderType Reader, HdlcFcsType Fcs >
 void HdlcAnalyzer::ProcessControlField()
 {
 	if( mAbortFrame )
@@ -473,15 +780,17 @@ void HdlcAnalyzer::ProcessControlField()
 	if( mSettings->mHdlcControl == HDLC_BASIC_CONTROL_FIELD ) // Basic Control Field of 1 byte
 	{
 		mCurrentField = HDLC_FIELD_BASIC_CONTROL;
-		HdlcByte controlByte = ReadByte(); if( mAbortFrame ) { return; }
+		HdlcByte controlByte = ReadByte< Reader, Fcs >(); if( mAbortFrame ) { return; }
 		
 		U8 flag = ( controlByte.escaped ) ? HDLC_ESCAPED_BYTE : 0;
 		Frame frame = CreateFrame( HDLC_FIELD_BASIC_CONTROL, controlByte.startSample, 
  								   controlByte.endSample, controlByte.value, 0, flag );
 		AddFrameToResults( frame );
 		
-		HdlcFrameType frameType = GetFrameType( controlByte.value );
-		mCurrentFrameIsSFrame = ( frameType == HDLC_S_FRAME );
+		// The type of the frame is the one of the real (unescaped) control byte
+		mFrameType = GetFrameType( controlByte.escaped ? HdlcAnalyzerSettings::Bit5Inv( controlByte.value ) : controlByte.value );
+		mFrameTypeKnown = true;
+		mCurrentFrameIsSFrame = ( mFrameType == HDLC_S_FRAME );
 		
 	}
 	else // Extended Control Field
@@ -489,8 +798,8 @@ void HdlcAnalyzer::ProcessControlField()
 		mCurrentField = HDLC_FIELD_EXTENDED_CONTROL;
 		
 		// Read first byte and check type of frame
-		HdlcByte byte0 = ReadByte(); if( mAbortFrame ) { return; }
-		HdlcFrameType frameType = GetFrameType( byte0.value );
+		HdlcByte byte0 = ReadByte< Reader, Fcs >(); if( mAbortFrame ) { return; }
+		HdlcFrameType frameType = GetFrameType( byte0.escaped ? HdlcAnalyzerSettings::Bit5Inv( byte0.value ) : byte0.value );
 		U8 flag = ( byte0.escaped ) ? HDLC_ESCAPED_BYTE : 0;
 		
 		Frame frame0 = CreateFrame( HDLC_FIELD_EXTENDED_CONTROL, byte0.startSample, byte0.endSample, 
@@ -498,6 +807,8 @@ void HdlcAnalyzer::ProcessControlField()
 		AddFrameToResults( frame0 );
 		
 		mCurrentFrameIsSFrame = ( frameType == HDLC_S_FRAME );
+		mFrameType = frameType;
+		mFrameTypeKnown = true;
 		
 		if( frameType != HDLC_U_FRAME )
 		{
@@ -510,7 +821,7 @@ void HdlcAnalyzer::ProcessControlField()
 			}
 			for( U32 i = 1; i < ctlBytes; ++i )
 			{
-				HdlcByte byte = ReadByte(); if( mAbortFrame ) { return; }
+				HdlcByte byte = ReadByte< Reader, Fcs >(); if( mAbortFrame ) { return; }
 				U8 flag = ( byte.escaped ) ? HDLC_ESCAPED_BYTE : 0;
 				Frame frame = CreateFrame( HDLC_FIELD_EXTENDED_CONTROL, byte.startSample, 
 										byte.endSample, byte.value, i, flag );
@@ -522,218 +833,558 @@ void HdlcAnalyzer::ProcessControlField()
 
 }
 
-vector<HdlcByte> HdlcAnalyzer::ReadProcessAndFcsField()
+template< HdlcByteReaderType Reader, HdlcFcsType Fcs >
+void HdlcAnalyzer::ProcessInfoAndFcsField()
 {
+	if( mAbortFrame )
+	{
+		return;
+	}
+	
+	mCurrentField = HDLC_FIELD_INFORMATION;
 	
-	vector<HdlcByte> infoAndFcs;
+	// The bytes up to the end flag are the HCS (if any), the information and the FCS when there
+	// are enough of them for the HCS and the FCS, else they're all information bytes. The bytes
+	// are emitted as they are read, only the ones that may still be the HCS or the FCS are held.
+	const U32 fcsBytes = HdlcCrcModelOf< Fcs >::Model::FcsBytes;
+	bool is16BitFcs = ( fcsBytes == 2 );
+	U32 hcsBytes = ( mSettings->mWithHcsField && !( is16BitFcs && mCurrentFrameIsSFrame ) ) ? fcsBytes : 0;
+	HdlcByte held[ 8 ];
+	U32 heldBytes = 0;
+	bool hcsDone = false;
+	U32 infoBytes = 0;
 	for( ; ; )
 	{
-		HdlcByte asyncByte = ReadByte(); if( mAbortFrame ) { return infoAndFcs; }
-		if( asyncByte.value == HDLC_FLAG_VALUE && mFoundEndFlag ) // End of frame found
+		HdlcByte byte = ReadByte< Reader, Fcs >(); if( mAbortFrame ) { break; }
+		if( byte.value == HDLC_FLAG_VALUE && mFoundEndFlag ) // End of frame found
 		{
-			mEndFlagFrameToEmit = CreateFrame( HDLC_FIELD_FLAG, asyncByte.startSample, 
-										asyncByte.endSample, HDLC_FLAG_END );
+			U64 stuffing = 0;
+			if( Reader != HDLC_READER_BYTE_ASYNC && mSettings->mStuffingMarkers == HDLC_STUFFING_COUNT )
+			{
+				stuffing = ( mFrameLength << 32 ) | mStuffedBits;
+			}
+			mEndFlagFrameToEmit = CreateFrame( HDLC_FIELD_FLAG, byte.startSample, 
+										byte.endSample, HDLC_FLAG_END, stuffing );
       mFoundEndFlag = false;
 			break;
 		}
-		else  // information or fcs byte
+		
+		if( FrameOversize( byte ) )
+		{
+			break;
+		}
+		Checkpoint( byte.endSample );
+		
+		if( hcsDone && heldBytes == fcsBytes ) // the oldest byte can't be part of the FCS
 		{
-			infoAndFcs.push_back( asyncByte );
+			ProcessInformationByte( held[ 0 ], infoBytes++ );
+			for( U32 i=1; i < heldBytes; ++i )
+			{
+				held[ i - 1 ] = held[ i ];
+			}
+			heldBytes--;
+		}
+		held[ heldBytes++ ] = byte;
+		
+		if( !hcsDone && heldBytes == hcsBytes + fcsBytes ) // the frame has a HCS and a FCS
+		{
+			if( hcsBytes > 0 )
+			{
+				ProcessFcsField( held[ 0 ].startSample, held[ hcsBytes - 1 ].endSample, HDLC_CRC_HCS );
+				for( U32 i=hcsBytes; i < heldBytes; ++i )
+				{
+					held[ i - hcsBytes ] = held[ i ];
+				}
+				heldBytes -= hcsBytes;
+			}
+			hcsDone = true;
 		}
 	}
 	
-	return infoAndFcs;
+	// Aborted or too short for the FCS: the held bytes are information bytes too
+	if( mAbortFrame || !hcsDone )
+	{
+		for( U32 i=0; i < heldBytes; ++i )
+		{
+			ProcessInformationByte( held[ i ], infoBytes++ );
+		}
+		EmitInformationChunk();
+		return;
+	}
 	
+	EmitInformationChunk();
+	ProcessFcsField( held[ 0 ].startSample, held[ heldBytes - 1 ].endSample, HDLC_CRC_FCS );
 }
 
-void HdlcAnalyzer::ProcessInfoAndFcsField()
+void HdlcAnalyzer::ProcessInformationByte( const HdlcByte & byte, U32 index )
 {
-	if( mAbortFrame )
+	if( mFrameFilterState == HDLC_FRAME_FILTER_REJECT )
 	{
 		return;
 	}
 	
-	mCurrentField = HDLC_FIELD_INFORMATION;
-	vector<HdlcByte> informationAndFcs = ReadProcessAndFcsField();
+	if( mSettings->mCompactInformationField )
+	{
+		// The byte goes to the arena and the field grows up to HDLC_INFORMATION_CHUNK_BYTES
+		U64 offset = mResults->AddPayloadByte( byte.value, byte.escaped );
+		if( !mHasInformationChunk )
+		{
+			mInformationChunk = CreateFrame( HDLC_FIELD_INFORMATION, byte.startSample, byte.endSample, 
+											 offset, U64( index ) << 32, HDLC_PAYLOAD_CHUNK );
+			mHasInformationChunk = true;
+		}
+		mInformationChunk.mEndingSampleInclusive = byte.endSample;
+		mInformationChunk.mData2++;
+		if( ( mInformationChunk.mData2 & 0xFFFFFFFF ) == HDLC_INFORMATION_CHUNK_BYTES )
+		{
+			EmitInformationChunk();
+		}
+		return;
+	}
+	
+	U8 flag = ( byte.escaped ) ? HDLC_ESCAPED_BYTE : 0;
+	Frame frame = CreateFrame( HDLC_FIELD_INFORMATION, byte.startSample, 
+							   byte.endSample, byte.value, index, flag );
+	AddFrameToResults( frame );
+}
+
+// Stuffed zero of the current frame: counted for the end flag, and marked unless the markers are
+// off (one every 5 bits of 0xFF bytes)
+void HdlcAnalyzer::AddStuffedBit( U64 sample )
+{
+	mStuffedBits++;
+	if( mSettings->mStuffingMarkers == HDLC_STUFFING_MARKERS )
+	{
+		AddMarkerToResults( sample, AnalyzerResults::Dot );
+	}
+}
+
+// The frame is dropped like an aborted one when a byte goes over the maximum frame length (e.g.
+// the closing flag was lost): the oversize record takes the place of the byte and the flags are
+// searched again
+bool HdlcAnalyzer::FrameOversize( const HdlcByte & byte )
+{
+	if( mFrameLength <= mSettings->mMaxFrameLength )
+	{
+		return false;
+	}
+	mAbortFrameToEmit = CreateFrame( HDLC_OVERSIZE_FRAME, byte.startSample, byte.endSample, 
+									 mSettings->mMaxFrameLength, 0, DISPLAY_AS_ERROR_FLAG );
+	mAbortFrame = true;
+	return true;
+}
+
+void HdlcAnalyzer::EmitInformationChunk()
+{
+	if( mHasInformationChunk )
+	{
+		AddFrameToResults( mInformationChunk );
+		mHasInformationChunk = false;
+	}
+}
+
+void HdlcAnalyzer::AddFrameToResults( Frame & frame )
+{
+  if( U64( frame.mStartingSampleInclusive ) < mLastFrameEndSample )
+  {
+    frame.mStartingSampleInclusive = mLastFrameEndSample + 1;
+  }
+  mLastFrameEndSample = frame.mEndingSampleInclusive;
+  
+  switch( mFrameFilterState )
+  {
+    case HDLC_FRAME_FILTER_PASS:
+      mResults->AddFrame( frame );
+      mCommitScheduler.ResultAdded();
+      break;
+    case HDLC_FRAME_FILTER_STAGE:
+      if( mStagedFrames.empty() )
+      {
+        mStagedFrameStart = frame.mStartingSampleInclusive;
+      }
+      mStagedFrames.push_back( frame );
+      break;
+    case HDLC_FRAME_FILTER_HOLD:
+      // Fill flags between the repeats: held up to a limit (e.g. a long idle line)
+      mHeldFrames.push_back( frame );
+      if( mHeldFrames.size() >= HDLC_REPEAT_MAX_HELD_FIELDS )
+      {
+        EndRepeatRun();
+      }
+      break;
+    case HDLC_FRAME_FILTER_REJECT:
+      break;
+  }
+}
 
-	InfoAndFcsField( informationAndFcs );
+void HdlcAnalyzer::AddMarkerToResults( U64 sample, AnalyzerResults::MarkerType type )
+{
+  if( mFrameFilterState == HDLC_FRAME_FILTER_STAGE )
+  {
+    HdlcMarker marker = { sample, type };
+    mStagedMarkers.push_back( marker );
+  }
+  else if( mFrameFilterState != HDLC_FRAME_FILTER_REJECT )
+  {
+    mResults->AddMarker( sample, type, mSettings->mInputChannel );
+  }
 }
 
-void HdlcAnalyzer::InfoAndFcsField(const vector<HdlcByte> & informationAndFcs)
+//
+///////////////////////////// Frame filter ///////////////////////////////////////////////
+//
+
+// The fields of a frame are staged from its start flag when a filter is set: the frame can't be
+// told apart before its address and control fields (or its FCS for the CRC filter) are read.
+// The frames that don't pass are decoded but nothing of them reaches the results (but a
+// summary field), so the results and the commits only grow with the frames of interest.
+// The frames that may repeat the frame before are staged too, until a byte differs.
+void HdlcAnalyzer::BeginFrameFilter()
 {
-	vector<HdlcByte> information = informationAndFcs;
-	vector<HdlcByte> hcs;
-	vector<HdlcByte> fcs;
+	mFrameAddress = 0;
+	mFrameAddressKnown = false;
+	mFrameTypeKnown = false;
+	mFrameCrcError = false;
+	mFilterPending = mSettings->FilterFrames();
+	mStagedFrameStart = mLastFrameEndSample + 1;
+	mFramePayloadSize = mResults->GetPayloadSize();
+	
+	// The bytes read before the start flag is emitted (the first byte in async mode)
+	mFrameMayRepeat = mHasRepeatCandidate && mFrameLength <= mRepeatLength;
+	for( U32 i=0; mFrameMayRepeat && i < mFrameLength; ++i )
+	{
+		mFrameMayRepeat = ( mFrameRepeatBytes[ i ] == mRepeatBytes[ i ] );
+	}
 	
-	if( !mAbortFrame ) 
+	if( mFilterPending || mFrameMayRepeat )
 	{
-		// split information and fcs vector
-		switch( mSettings->mHdlcFcs )
+		mFrameFilterState = HDLC_FRAME_FILTER_STAGE;
+	}
+	else
+	{
+		EndRepeatRun();
+		mFrameFilterState = HDLC_FRAME_FILTER_PASS;
+	}
+}
+
+// Called after the control field (or when the frame ended before it)
+void HdlcAnalyzer::FilterFrameHeader()
+{
+	if( !mFilterPending )
+	{
+		return;
+	}
+	
+	if( !FrameHeaderMatches() )
+	{
+		mFilterPending = false;
+		RejectFrame();
+	}
+	else if( !mSettings->mFilterCrcErrorsOnly )
+	{
+		mFilterPending = false;
+		if( !mFrameMayRepeat )
 		{
-			case HDLC_CRC8:
-			{
-				if( ( !information.empty() && ( !mSettings->mWithHcsField ) ) || 
-					( information.size() >= 2 && ( mSettings->mWithHcsField ) ) )
-				{
-					if( mSettings->mWithHcsField )
-					{
-						hcs.push_back( information.front() );
-						information.erase( information.begin() );
-					}
-					fcs.push_back( information.back() );
-					information.pop_back();
-				}
-				break;
-			}
-			case HDLC_CRC16:
-			{
-				if( ( information.size() >= 2 && !mSettings->mWithHcsField ) || 
-					( information.size() >= 4 && mSettings->mWithHcsField ) ||
-					( information.size() >= 2 && mSettings->mWithHcsField && mCurrentFrameIsSFrame ) )
-				{
-					if( mSettings->mWithHcsField && !mCurrentFrameIsSFrame )
-					{
-						hcs.insert( hcs.end(), information.begin(), information.begin()+2 );
-						information.erase( information.begin(), information.begin()+2 );
-					}
-					fcs.insert( fcs.end(), information.end()-2, information.end() );
-					information.erase( information.end()-2, information.end() );
-				}
-				break;
-			}
-			case HDLC_CRC32:
-			{
-				if( ( information.size() >= 4 && ( !mSettings->mWithHcsField ) ) || 
-					( information.size() >= 8 && ( mSettings->mWithHcsField ) ) )
-				{
-					if( mSettings->mWithHcsField )
-					{
-						hcs.insert( hcs.end(), information.begin(), information.begin()+4 );
-						information.erase( information.begin(), information.begin()+4 );
-					}
-					fcs.insert( fcs.end(), information.end()-4, information.end() );
-					information.erase( information.end()-4, information.end() );
-				}
-				break;
-			}
+			PassFrame();
+		}
+	}
+	// else the FCS/HCS decides at the end of the frame
+}
+
+// Called after the end flag or the abort of the frame
+void HdlcAnalyzer::EndFrameFilter()
+{
+	if( mFrameFilterState == HDLC_FRAME_FILTER_STAGE )
+	{
+		if( mFilterPending && !mFrameCrcError )
+		{
+			RejectFrame();
+		}
+		else if( !mFilterPending && FrameRepeats() )
+		{
+			AddRepeatedFrame();
+		}
+		else
+		{
+			PassFrame();
+		}
+	}
+	
+	if( mFrameFilterState == HDLC_FRAME_FILTER_REJECT )
+	{
+		// The payload bytes of the frame were never shown
+		mResults->TruncatePayload( mFramePayloadSize );
+		if( mSettings->mFilteredFrames == HDLC_FILTERED_SUMMARY )
+		{
+			EndRepeatRun();
+			U8 flags = mFrameAddressKnown ? 0 : HDLC_FILTERED_NO_ADDRESS;
+			Frame frame = CreateFrame( HDLC_FILTERED_FRAME, mStagedFrameStart, mLastFrameEndSample, 
+									   mFrameAddress, mFrameLength, flags );
+			mResults->AddFrame( frame );
+			mCommitScheduler.ResultAdded();
+		}
+	}
+	
+	// A complete frame shown can be repeated by the next ones
+	if( mSettings->mCollapseRepeatedFrames && mFrameFilterState == HDLC_FRAME_FILTER_PASS )
+	{
+		mHasRepeatCandidate = !mAbortFrame && !mFrameCrcError && mFrameLength <= HDLC_REPEAT_MAX_BYTES;
+		mRepeatLength = mFrameLength;
+		for( U32 i=0; mHasRepeatCandidate && i < mRepeatLength; ++i )
+		{
+			mRepeatBytes[ i ] = mFrameRepeatBytes[ i ];
 		}
 	}
+	
+	mFilterPending = false;
+	mFrameMayRepeat = false;
+	mFrameFilterState = mHasRepeatCandidate ? HDLC_FRAME_FILTER_HOLD : HDLC_FRAME_FILTER_PASS;
+}
 
-	if( !mAbortFrame ) 
+// A frame that ended before its address or type fails the address or type filter
+bool HdlcAnalyzer::FrameHeaderMatches() const
+{
+	if( mSettings->mAddressFilter != HDLC_ADDRESS_FILTER_OFF )
 	{
-		if( !hcs.empty() )
+		if( !mFrameAddressKnown )
 		{
-			ProcessFcsField( hcs, HDLC_CRC_HCS );
+			return false;
+		}
+		bool listed = binary_search( mSettings->mFilterAddresses.begin(), mSettings->mFilterAddresses.end(), 
+									 mFrameAddress );
+		if( listed != ( mSettings->mAddressFilter == HDLC_ADDRESS_FILTER_ALLOW ) )
+		{
+			return false;
 		}
 	}
 	
-	ProcessInformationField( information );
-		
-	if( !mAbortFrame ) 
+	if( mSettings->mFrameTypeFilter != HDLC_FRAME_TYPE_FILTER_ALL )
 	{
-		if( !fcs.empty() )
+		if( !mFrameTypeKnown )
 		{
-			ProcessFcsField( fcs, HDLC_CRC_FCS );
+			return false;
+		}
+		HdlcFrameType frameType = HDLC_I_FRAME;
+		switch( mSettings->mFrameTypeFilter )
+		{
+			case HDLC_FRAME_TYPE_FILTER_I: frameType = HDLC_I_FRAME; break;
+			case HDLC_FRAME_TYPE_FILTER_S: frameType = HDLC_S_FRAME; break;
+			case HDLC_FRAME_TYPE_FILTER_U: frameType = HDLC_U_FRAME; break;
+			default: break;
+		}
+		if( mFrameType != frameType )
+		{
+			return false;
 		}
 	}
 	
+	return true;
 }
 
-void HdlcAnalyzer::ProcessInformationField( const vector<HdlcByte> & information )
+// The staged fields and markers go to the results (after the repeats before them) and the rest
+// of the frame follows them
+void HdlcAnalyzer::PassFrame()
 {
-	for( U32 i=0; i<information.size(); ++i )
+	EndRepeatRun();
+	for( U32 i=0; i < mStagedFrames.size(); ++i )
 	{
-		HdlcByte byte = information.at( i );
-		U8 flag = ( byte.escaped ) ? HDLC_ESCAPED_BYTE : 0;
-		Frame frame = CreateFrame( HDLC_FIELD_INFORMATION, byte.startSample, 
-								   byte.endSample, byte.value, i, flag );
-		AddFrameToResults( frame );
+		mResults->AddFrame( mStagedFrames[ i ] );
 	}
+	for( U32 i=0; i < mStagedMarkers.size(); ++i )
+	{
+		mResults->AddMarker( mStagedMarkers[ i ].sample, mStagedMarkers[ i ].type, mSettings->mInputChannel );
+	}
+	if( !mStagedFrames.empty() )
+	{
+		mCommitScheduler.ResultAdded();
+	}
+	mStagedFrames.clear();
+	mStagedMarkers.clear();
+	mFrameFilterState = HDLC_FRAME_FILTER_PASS;
 }
 
-void HdlcAnalyzer::AddFrameToResults( Frame & frame )
+void HdlcAnalyzer::RejectFrame()
 {
-  mResultFrames.push_back( frame );
+	mStagedFrames.clear();
+	mStagedMarkers.clear();
+	mFrameFilterState = HDLC_FRAME_FILTER_REJECT;
 }
 
-bool HdlcAnalyzer::CrcOk( const vector<U8> & remainder ) const
+//
+///////////////////////////// Repeated frames ////////////////////////////////////////////
+//
+
+// Called for every byte of the frame (address to FCS) when the repeated frames are collapsed:
+// the frame stops being a possible repeat at the first byte that differs from the frame before,
+// and is shown from then on (unless the filter still has to decide)
+void HdlcAnalyzer::CheckRepeatedByte( U8 value )
 {
-  for( U32 i=0; i < remainder.size(); ++i )
+	U64 index = mFrameLength - 1;
+	if( index < HDLC_REPEAT_MAX_BYTES )
 	{
-		if( remainder.at( i ) != 0x00 )
+		mFrameRepeatBytes[ index ] = value;
+	}
+	
+	if( mFrameMayRepeat && ( index >= mRepeatLength || value != mRepeatBytes[ index ] ) )
+	{
+		mFrameMayRepeat = false;
+		if( !mFilterPending && mFrameFilterState == HDLC_FRAME_FILTER_STAGE )
 		{
-			return false;
+			PassFrame();
 		}
 	}
-	return true;
 }
 
-void HdlcAnalyzer::ProcessFcsField( const vector<HdlcByte> & fcs, HdlcCrcField crcFieldType )
+bool HdlcAnalyzer::FrameRepeats() const
 {
-  vector<U8> calculatedFcs;
-  vector<U8> readFcs = HdlcBytesToVectorBytes( fcs );
-  
-  switch( mSettings->mHdlcFcs )
+	return mFrameMayRepeat && !mAbortFrame && !mFrameCrcError && mFrameLength == mRepeatLength;
+}
+
+// The repeat and the fields held before it are dropped and counted in the repeats field, which
+// goes from the first field after the frame shown to the end flag of the last repeat
+void HdlcAnalyzer::AddRepeatedFrame()
+{
+	if( mRepeatCount == 0 )
+	{
+		mRepeatStart = mHeldFrames.empty() ? mStagedFrameStart : mHeldFrames.front().mStartingSampleInclusive;
+	}
+	mRepeatEnd = mLastFrameEndSample;
+	mRepeatCount++;
+	mHeldFrames.clear();
+	mStagedFrames.clear();
+	mStagedMarkers.clear();
+	mResults->TruncatePayload( mFramePayloadSize );
+}
+
+// The repeats counted so far (mData1 is their number and mData2 the bytes of the frame) and the
+// fields held after them go to the results. The frame shown can still be repeated afterwards.
+void HdlcAnalyzer::EndRepeatRun()
+{
+	if( mRepeatCount > 0 )
+	{
+		Frame frame = CreateFrame( HDLC_REPEATED_FRAMES, mRepeatStart, mRepeatEnd, mRepeatCount, mRepeatLength );
+		mResults->AddFrame( frame );
+		mCommitScheduler.ResultAdded();
+		mRepeatCount = 0;
+	}
+	if( !mHeldFrames.empty() )
+	{
+		for( U32 i=0; i < mHeldFrames.size(); ++i )
+		{
+			mResults->AddFrame( mHeldFrames[ i ] );
+		}
+		mCommitScheduler.ResultAdded();
+		mHeldFrames.clear();
+	}
+}
+
+void HdlcAnalyzer::ResetFrameCrc()
+{
+	mFrameCrc = HdlcCrc::Init( mSettings->mHdlcFcs );
+	mCrcDelayLineIndex = 0;
+	mCrcDelayLineSize = 0;
+	mHeaderCrc = mFrameCrc;
+	mHcsBytesRead = 0;
+	mHeaderCrcTaken = false;
+	mHeaderBytes = 0;
+	mFrameBitSamples.clear();
+	mFrameLength = 0;
+	mStuffedBits = 0;
+}
+
+template< HdlcFcsType Fcs >
+void HdlcAnalyzer::AddByteToFrameCrc( U8 value )
+{
+	typedef typename HdlcCrcModelOf< Fcs >::Model Model;
+	
+	mFrameLength++;
+	
+	if( mSettings->mCollapseRepeatedFrames )
+	{
+		CheckRepeatedByte( value );
+	}
+	
+	// No error can be located in a frame longer than the syndrome table, one more byte tells it
+	if( mSettings->mLocateBitErrors && mFrameBitSamples.size() <= mSyndromeTable.GetMaxBits() )
+	{
+		mFrameBitSamples.insert( mFrameBitSamples.end(), mByteBitSamples, mByteBitSamples + 8 );
+	}
+	
+	if( mHeaderCrcTaken && mHcsBytesRead < Model::FcsBytes )
+	{
+		mHcsBytes[ mHcsBytesRead++ ] = value;
+	}
+	
+	// The oldest byte of the delay line can't be part of the FCS anymore
+	if( mCrcDelayLineSize == Model::FcsBytes )
+	{
+		mFrameCrc = Model::UpdateByte( mFrameCrc, mCrcDelayLine[ mCrcDelayLineIndex ] );
+	}
+	else
+	{
+		mCrcDelayLineSize++;
+	}
+	
+	mCrcDelayLine[ mCrcDelayLineIndex ] = value;
+	mCrcDelayLineIndex = ( mCrcDelayLineIndex + 1 ) % Model::FcsBytes;
+}
+
+void HdlcAnalyzer::SnapshotHeaderCrc()
+{
+	// The header CRC covers all the bytes read so far, delay line included
+	mHeaderCrc = mFrameCrc;
+	U32 index = ( mCrcDelayLineIndex + mFcsBytes - mCrcDelayLineSize ) % mFcsBytes;
+	for( U32 i=0; i < mCrcDelayLineSize; ++i )
+	{
+		mHeaderCrc = HdlcCrc::UpdateByte( mSettings->mHdlcFcs, mHeaderCrc, mCrcDelayLine[ index ] );
+		index = ( index + 1 ) % mFcsBytes;
+	}
+	mHcsBytesRead = 0;
+	mHeaderCrcTaken = true;
+	mHeaderBytes = mFrameBitSamples.size() / 8;
+}
+
+void HdlcAnalyzer::ProcessFcsField( U64 startSample, U64 endSample, HdlcCrcField crcFieldType )
+{
+  U8 fcsBytes[ 4 ];
+  U32 crc;
+  if( crcFieldType == HDLC_CRC_FCS )
   {
-    case HDLC_CRC8:
+    // The FCS bytes are the ones in the delay line, the CRC of the rest of the frame is ready
+    U32 index = ( mCrcDelayLineIndex + mFcsBytes - mCrcDelayLineSize ) % mFcsBytes;
+    for( U32 i=0; i < mCrcDelayLineSize; ++i )
     {
-      if( crcFieldType == HDLC_CRC_FCS )
-      {
-        if( !mCurrentFrameBytes.empty() )
-        {
-          mCurrentFrameBytes.pop_back();
-        }
-        calculatedFcs = HdlcSimulationDataGenerator::Crc8( mCurrentFrameBytes );
-      }
-      else
-      {
-        calculatedFcs = HdlcSimulationDataGenerator::Crc8( mCurrentFrameBytesForHCS );
-      }
-      break;
+      fcsBytes[ i ] = mCrcDelayLine[ index ];
+      index = ( index + 1 ) % mFcsBytes;
     }
-    case HDLC_CRC16:
-    {
-      if( crcFieldType == HDLC_CRC_FCS )
-      {
-        if( mCurrentFrameBytes.size() >= 2 )
-        {
-          mCurrentFrameBytes.erase( mCurrentFrameBytes.end()-2, mCurrentFrameBytes.end() );
-        }
-        
-        calculatedFcs = HdlcSimulationDataGenerator::Crc16( mCurrentFrameBytes );
-        
-      }
-      else
-      {
-        calculatedFcs = HdlcSimulationDataGenerator::Crc16( mCurrentFrameBytesForHCS );
-      }
-      break;
-    }
-    case HDLC_CRC32:
+    crc = mFrameCrc;
+  }
+  else
+  {
+    for( U32 i=0; i < mFcsBytes; ++i )
     {
-      if( crcFieldType == HDLC_CRC_FCS )
-      {
-        if( mCurrentFrameBytes.size() >= 4 )
-        {
-          mCurrentFrameBytes.erase( mCurrentFrameBytes.end()-4, mCurrentFrameBytes.end() );
-        }
-        calculatedFcs = HdlcSimulationDataGenerator::Crc32( mCurrentFrameBytes );
-      }
-      else
-      {
-        calculatedFcs = HdlcSimulationDataGenerator::Crc32( mCurrentFrameBytesForHCS );
-      }
-      break;
+      fcsBytes[ i ] = mHcsBytes[ i ];
     }
+    crc = mHeaderCrc;
   }
   
+  U64 readFcs = HdlcCrc::BytesToCrc( mSettings->mHdlcFcs, fcsBytes );
+  U64 calculatedFcs = HdlcCrc::Final( mSettings->mHdlcFcs, crc );
+  
   HdlcFieldType frameType = ( crcFieldType == HDLC_CRC_HCS ) ? HDLC_FIELD_HCS : HDLC_FIELD_FCS;
-  Frame frame = CreateFrame( frameType, fcs.front().startSample, fcs.back().endSample, 
-                VectorToValue(readFcs), VectorToValue(calculatedFcs) );
+  Frame frame = CreateFrame( frameType, startSample, endSample, readFcs, calculatedFcs );
   
-  if( calculatedFcs != readFcs )
+  // The CRC of the frame followed by a correct FCS is the residue of the CRC
+  U32 syndrome = HdlcCrc::Update( mSettings->mHdlcFcs, crc, fcsBytes, mFcsBytes ) ^ HdlcCrc::Residue( mSettings->mHdlcFcs );
+  if( syndrome != 0 )
   {
     frame.mFlags = DISPLAY_AS_ERROR_FLAG;
+    mFrameCrcError = true;
+    if( mSettings->mLocateBitErrors )
+    {
+      U32 checkedBytes = ( crcFieldType == HDLC_CRC_FCS ) ? mFrameBitSamples.size() / 8 : mHeaderBytes + mFcsBytes;
+      LocateBitError( frame, syndrome, checkedBytes );
+    }
   }
   
   AddFrameToResults( frame );
@@ -741,17 +1392,42 @@ void HdlcAnalyzer::ProcessFcsField( const vector<HdlcByte> & fcs, HdlcCrcField c
   if( crcFieldType == HDLC_CRC_FCS )
   {
     // Put a marker in the end of the HDLC frame
-    mResults->AddMarker( frame.mEndingSampleInclusive, AnalyzerResults::Stop, mSettings->mInputChannel );
+    AddMarkerToResults( frame.mEndingSampleInclusive, AnalyzerResults::Stop );
   }
   
 }
 
+// The position of the flipped bit (+1) goes in the upper 32 bits of mData2 of the FCS/HCS frame,
+// counting the bits from the start of the frame, and a marker is put on it
+void HdlcAnalyzer::LocateBitError( Frame & frame, U32 syndrome, U32 checkedBytes )
+{
+  U32 bitFromEnd;
+  if( checkedBytes * 8 > mFrameBitSamples.size() || checkedBytes * 8 > mSyndromeTable.GetMaxBits() ||
+      !mSyndromeTable.Lookup( syndrome, bitFromEnd ) || bitFromEnd >= checkedBytes * 8 )
+  {
+    return;
+  }
+  
+  U32 byteIndex = checkedBytes - 1 - bitFromEnd / 8;
+  U32 bitNumber = bitFromEnd % 8;
+  frame.mData2 |= U64( byteIndex * 8 + bitNumber + 1 ) << 32;
+  
+  // The bits of a byte are transmitted lsb first
+  AddMarkerToResults( mFrameBitSamples[ byteIndex * 8 + bitNumber ], AnalyzerResults::ErrorDot );
+}
+
+template< HdlcByteReaderType Reader, HdlcFcsType Fcs >
 HdlcByte HdlcAnalyzer::ReadByte()
 {
-	return ( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BYTE_ASYNC )
-		   ? ByteAsyncReadByte() : BitSyncReadByte();
+	switch( Reader )
+	{
+		case HDLC_READER_BYTE_ASYNC: return ByteAsyncReadByte< Fcs >();
+		case HDLC_READER_BIT_SYNC_EDGES: return BitSyncEdgeReadByte< Fcs >();
+		default: return BitSyncReadByte< Fcs >();
+	}
 }
 
+template< HdlcFcsType Fcs >
 HdlcByte HdlcAnalyzer::ByteAsyncReadByte()
 {
 	HdlcByte ret = ByteAsyncReadByte_();
@@ -772,7 +1448,7 @@ HdlcByte HdlcAnalyzer::ByteAsyncReadByte()
 		else
 		{
 			// Real data: with the bit-5 inverted (that's what we use for the crc)
-			mCurrentFrameBytes.push_back( HdlcAnalyzerSettings::Bit5Inv( ret.value ) );
+			AddByteToFrameCrc< Fcs >( HdlcAnalyzerSettings::Bit5Inv( ret.value ) );
 			ret.startSample = startSampleEsc;
 			ret.escaped = true;
 			return ret;
@@ -781,49 +1457,87 @@ HdlcByte HdlcAnalyzer::ByteAsyncReadByte()
 	
 	if( mReadingFrame && ret.value != HDLC_FLAG_VALUE )
 	{
-		mCurrentFrameBytes.push_back( ret.value );
+		AddByteToFrameCrc< Fcs >( ret.value );
+	}
+	else if( mReadingFrame ) // a flag that is not escaped
+	{
+		mFoundEndFlag = true;
 	}
 	
 	return ret;
 }
 
+// Start/stop character: start bit (0), 8 data bits (lsb first) and stop bit (1). The bits are
+// taken from the edges inside the character, at the middle of each bit counted from the start
+// edge with a fractional bit period, so the rounding of the period doesn't add up along the byte.
 HdlcByte HdlcAnalyzer::ByteAsyncReadByte_()
 {
+	U64 sample = mHdlc->GetSampleNumber();
+	
 	// Line must be HIGH here
 	if( mHdlc->GetBitState() == BIT_LOW )
 	{
-		mHdlc->AdvanceToNextEdge();
+		sample = SampleOfNextEdge( sample );
+		mHdlc->AdvanceToAbsPosition( sample );
 	}
 	
-	mHdlc->AdvanceToNextEdge(); // high->low transition (start bit)
-	
-	mHdlc->Advance( mSamplesInHalfPeriod * 0.5 );
-	// BitState startBit = mHdlc->GetBitState(); // start bit position
+	U64 startEdge = SampleOfNextEdge( sample ); // high->low transition (start bit)
+	mHdlc->AdvanceToAbsPosition( startEdge );
 	
-	U64 byteStartSample = mHdlc->GetSampleNumber() + mSamplesInHalfPeriod * 0.5; 
+	// Middle of the stop bit: the last sample of the character
+	U64 characterEnd = AsyncBitMiddle( startEdge, HDLC_ASYNC_STOP_BIT );
 	
-	U64 byteValue2= 0;
-	DataBuilder dbyte;
-	dbyte.Reset( &byteValue2, AnalyzerEnums::LsbFirst, 8 );
-	
-	for( U32 i=0; i<8 ; ++i )
+	U8 byteValue = 0;
+	BitState bitState = BIT_LOW;
+	U32 bit = 1; // first data bit
+	U64 edge = startEdge;
+	// All the edges up to the middle of the stop bit are read (the stop bit state is the line
+	// state for the next character)
+	while( EdgeComing( edge, characterEnd ) )
 	{
-		mHdlc->Advance( mSamplesInHalfPeriod );
-		dbyte.AddBit( mHdlc->GetBitState() );
+		edge = SampleOfNextEdge( edge );
+		mHdlc->AdvanceToAbsPosition( edge );
+		// The bits with the middle before the edge have the previous state
+		for( ; bit < HDLC_ASYNC_STOP_BIT && AsyncBitMiddle( startEdge, bit ) < edge; ++bit )
+		{
+			if( bitState == BIT_HIGH )
+			{
+				byteValue |= 1 << ( bit - 1 );
+			}
+		}
+		bitState = ( bitState == BIT_HIGH ) ? BIT_LOW : BIT_HIGH;
+	}
+	// No more edges up to the end of the character
+	for( ; bit < HDLC_ASYNC_STOP_BIT; ++bit )
+	{
+		if( bitState == BIT_HIGH )
+		{
+			byteValue |= 1 << ( bit - 1 );
+		}
 	}
 	
-	U8 byteValue = U8( byteValue2 );
-
-	U64 byteEndSample = mHdlc->GetSampleNumber() + mSamplesInHalfPeriod * 0.5; 
- 
-	mHdlc->Advance( mSamplesInHalfPeriod );
-	// BitState endBit = mHdlc->GetBitState(); // stop bit position
-
+	// The byte goes from the start of the first data bit to the start of the stop bit
+	U64 byteStartSample = startEdge + ( mAsyncSamplesPerBit >> 16 );
+	U64 byteEndSample = startEdge + ( ( HDLC_ASYNC_STOP_BIT * mAsyncSamplesPerBit ) >> 16 );
+	
 	HdlcByte asyncByte = { byteStartSample, byteEndSample, byteValue, false };
 	
+	if( mSettings->mLocateBitErrors )
+	{
+		for( U32 i=0; i < 8; ++i )
+		{
+			mByteBitSamples[ i ] = AsyncBitMiddle( startEdge, i + 1 );
+		}
+	}
+	
 	return asyncByte;
 }
 
+U64 HdlcAnalyzer::AsyncBitMiddle( U64 startEdge, U32 bit ) const
+{
+	return startEdge + ( ( ( 2 * bit + 1 ) * mAsyncSamplesPerBit ) >> 17 );
+}
+
 
 //
 ///////////////////////////// Helper functions ///////////////////////////////////////////
@@ -843,28 +1557,6 @@ Frame HdlcAnalyzer::CreateFrame( U8 mType, U64 mStartingSampleInclusive, U64 mEn
 	return frame;
 }
 
-vector<U8> HdlcAnalyzer::HdlcBytesToVectorBytes( const vector<HdlcByte> & asyncBytes ) const
-{
-	vector<U8> ret;
-	for( U32 i=0; i < asyncBytes.size(); ++i )
-	{
-		ret.push_back( asyncBytes[ i ].value );
-	}
-	return ret;
-}
-
-U64 HdlcAnalyzer::VectorToValue( const vector<U8> & v ) const
-{
-	U64 value=0;
-	U32 j= 8 * ( v.size() - 1 );
-	for( U32 i=0; i < v.size(); ++i )
-	{
-		value |= (v.at(i) << j);
-		j-=8;
-	}
-	return value;
-}
-
 HdlcFrameType HdlcAnalyzer::GetFrameType( U8 value )
 {
 	if( value & 0x01 )
@@ -884,6 +1576,11 @@ HdlcFrameType HdlcAnalyzer::GetFrameType( U8 value )
 	}
 }
 
+const HdlcCommitScheduler & HdlcAnalyzer::GetCommitScheduler() const
+{
+	return mCommitScheduler;
+}
+
 bool HdlcAnalyzer::NeedsRerun()
 {
 	return false;
@@ -902,6 +1599,12 @@ U32 HdlcAnalyzer::GenerateSimulationData( U64 minimum_sample_index, U32 device_s
 
 U32 HdlcAnalyzer::GetMinimumSampleRateHz()
 {
+	if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BIT_SYNC && 
+		mSettings->mBitSyncDecoder == HDLC_BIT_SYNC_DECODER_DPLL )
+	{
+		// The recovered clock averages the quantization of the edges
+		return mSettings->mBitRate * 2 + mSettings->mBitRate / 2;
+	}
 	return mSettings->mBitRate * 4;
 }
 
@@ -4,6 +4,9 @@
 #include <Analyzer.h>
 #include "HdlcAnalyzerResults.h"
 #include "HdlcSimulationDataGenerator.h"
+#include "HdlcCrc.h"
+#include "HdlcBitSyncDecoder.h"
+#include "HdlcCommitScheduler.h"
 
 struct HdlcByte 
 {
@@ -13,6 +16,25 @@ struct HdlcByte
 	bool escaped;
 };
 
+// Marker of the results (kept with the fields of a frame until the frame filter decides)
+struct HdlcMarker
+{
+	U64 sample;
+	AnalyzerResults::MarkerType type;
+};
+
+// Fields of the current frame: added to the results, kept until the frame filter decides (the
+// address and control fields, or the FCS too for the CRC filter) or the frame is known not to be
+// a repeat, or dropped. Between the frames, the fields after a frame that may be repeated are held.
+enum HdlcFrameFilterState { HDLC_FRAME_FILTER_PASS = 0, HDLC_FRAME_FILTER_STAGE, HDLC_FRAME_FILTER_REJECT, 
+							HDLC_FRAME_FILTER_HOLD };
+
+// Longest frame (address to FCS) collapsed when repeated
+#define HDLC_REPEAT_MAX_BYTES 64
+
+// Byte reader of the frame decoder: transmission mode and, in bit sync mode, the decoder of the bits
+enum HdlcByteReaderType { HDLC_READER_BIT_SYNC_SAMPLING = 0, HDLC_READER_BIT_SYNC_EDGES, HDLC_READER_BYTE_ASYNC };
+
 class HdlcAnalyzerSettings;
 class ANALYZER_EXPORT HdlcAnalyzer : public Analyzer
 {
@@ -28,61 +50,136 @@ public:
 	virtual bool NeedsRerun();
 	
 	static HdlcFrameType GetFrameType( U8 value );
+	const HdlcCommitScheduler & GetCommitScheduler() const;
 	
 protected:
 	
 	void SetupAnalyzer();
 	
-	// Functions to read and process a HDLC frame
-	void ProcessHDLCFrame();
-	HdlcByte ProcessFlags();
-	void ProcessAddressField( HdlcByte byteAfterFlag );
-	void ProcessControlField();
-	void ProcessInfoAndFcsField();
-	vector<HdlcByte> ReadProcessAndFcsField();
-	void InfoAndFcsField( const vector<HdlcByte> & informationAndFcs );
-	void ProcessInformationField( const vector<HdlcByte> & information );
-	void ProcessFcsField( const vector<HdlcByte> & fcs, HdlcCrcField crcFieldType );
-	HdlcByte ReadByte();
+	void CommitResults();
+	bool HasPendingResults() const;
+	void CommitPendingResults();
+	void CommitIfWaitingForData();
+	U64 SampleOfNextEdge( U64 sample );
+	bool EdgeComing( U64 sample, U64 end );
+	void Checkpoint( U64 sample );
+	
+	// Frame decoder for the byte reader and the FCS type of the settings
+	typedef void ( HdlcAnalyzer::*FrameDecoder )();
+	void SelectFrameDecoder();
+	template< HdlcByteReaderType Reader > FrameDecoder FrameDecoderFor( HdlcFcsType fcsType ) const;
+	
+	// Functions to read and process a HDLC frame. The ones called for every byte are instantiated
+	// for every byte reader and FCS type.
+	template< HdlcByteReaderType Reader, HdlcFcsType Fcs > void ProcessHDLCFrame();
+	template< HdlcByteReaderType Reader, HdlcFcsType Fcs > HdlcByte ProcessFlags();
+	template< HdlcByteReaderType Reader, HdlcFcsType Fcs > void ProcessAddressField( HdlcByte byteAfterFlag );
+	template< HdlcByteReaderType Reader, HdlcFcsType Fcs > void ProcessControlField();
+	template< HdlcByteReaderType Reader, HdlcFcsType Fcs > void ProcessInfoAndFcsField();
+	void ProcessInformationByte( const HdlcByte & byte, U32 index );
+	void EmitInformationChunk();
+	bool FrameOversize( const HdlcByte & byte );
+	void AddStuffedBit( U64 sample );
+	void ProcessFcsField( U64 startSample, U64 endSample, HdlcCrcField crcFieldType );
+	template< HdlcByteReaderType Reader, HdlcFcsType Fcs > HdlcByte ReadByte();
 	
 	// Bit Sync Transmission functions
 	void BitSyncProcessFlags();
-	BitState BitSyncReadBit();	
-	HdlcByte BitSyncReadByte();
+	BitState BitSyncReadBit( U64 & bitSample );	
+	template< HdlcFcsType Fcs > HdlcByte BitSyncReadByte();
 	HdlcByte BitSyncProcessFirstByteAfterFlag( HdlcByte firstAddressByte );
-	bool FlagComing();
-	bool AbortComing();
+	U64 SamplesToNextEdge();
+	bool FlagComing( U64 samplesToNextEdge ) const;
+	bool AbortComing( U64 samplesToNextEdge ) const;
+	
+	// Bit Sync Transmission with the edge interval decoder
+	HdlcBitSyncItem NextBitSyncItem();
+	void BitSyncEdgeProcessFlags();
+	template< HdlcFcsType Fcs > HdlcByte BitSyncEdgeReadByte();
+	bool UseBitSyncEdgeDecoder() const;
+	
+	// Flags before a frame (all the modes)
+	void ResetFlagRun();
+	void AddFlagToRun( const HdlcByte & flag );
+	void AddFillFlag( const HdlcByte & flag );
+	void EmitFlagRun( bool startFlag );
 	
 	// Byte Async Transmission functions
-	HdlcByte ByteAsyncProcessFlags();
-	void GenerateFlagsFrames( vector<HdlcByte> readBytes ) ;
-	HdlcByte ByteAsyncReadByte();
+	template< HdlcFcsType Fcs > HdlcByte ByteAsyncProcessFlags();
+	template< HdlcFcsType Fcs > HdlcByte ByteAsyncReadByte();
 	HdlcByte ByteAsyncReadByte_();
+	U64 AsyncBitMiddle( U64 startEdge, U32 bit ) const;
 	
 	// Helper functions
-	bool CrcOk( const vector<U8> & remainder ) const;
+	void ResetFrameCrc();
+	template< HdlcFcsType Fcs > void AddByteToFrameCrc( U8 value );
+	void SnapshotHeaderCrc();
+	void LocateBitError( Frame & frame, U32 syndrome, U32 checkedBytes );
 	Frame CreateFrame( U8 mType, U64 mStartingSampleInclusive, U64 mEndingSampleInclusive, 
 					   U64 mData1=0, U64 mData2=0, U8 mFlags=0 ) const;
-	vector<U8> HdlcBytesToVectorBytes( const vector<HdlcByte> & asyncBytes ) const;
-	U64 VectorToValue( const vector<U8> & v ) const;
   
   void AddFrameToResults( Frame & frame );
-  void CommitFrames();
-  static bool FrameComparison(const Frame & frame0, const Frame & frame2);
+	void AddMarkerToResults( U64 sample, AnalyzerResults::MarkerType type );
+	
+	// Frame filter
+	void BeginFrameFilter();
+	void FilterFrameHeader();
+	void EndFrameFilter();
+	bool FrameHeaderMatches() const;
+	void PassFrame();
+	void RejectFrame();
+	
+	// Repeated frames
+	void CheckRepeatedByte( U8 value );
+	bool FrameRepeats() const;
+	void AddRepeatedFrame();
+	void EndRepeatRun();
 	
 protected:
   
 	std::auto_ptr< HdlcAnalyzerSettings > mSettings;
 	std::auto_ptr< HdlcAnalyzerResults > mResults;
 	AnalyzerChannelData* mHdlc;
+	HdlcBitSyncDecoder mBitSyncDecoder;
+	HdlcCommitScheduler mCommitScheduler;
+	FrameDecoder mProcessFrame;
 	
 	U32 mSampleRateHz;
 	U64 mSamplesInHalfPeriod;
 	U64 mSamplesInAFlag;
 	U32 mSamplesIn8Bits;
+	// Bit period in 1/65536 samples (start/stop characters)
+	U64 mAsyncSamplesPerBit;
+	// Sample distance between the progress/cancellation checks, and the next one
+	U64 mCheckpointSamples;
+	U64 mNextCheckpointSample;
+	// Next edge after the last position looked at: the data is known to reach it
+	U64 mNextEdgeSample;
+	
+	// Running CRC of the current frame. The last mFcsBytes bytes read are held in a delay line
+	// since they might be the FCS, and are added to the CRC when the next byte of the frame arrives.
+	U32 mFcsBytes;
+	U32 mFrameCrc;
+	U8 mCrcDelayLine[ 4 ];
+	U32 mCrcDelayLineIndex;
+	U32 mCrcDelayLineSize;
+	// Bytes of the current frame (address to FCS)
+	U64 mFrameLength;
+	// Stuffed zeros of the current frame
+	U32 mStuffedBits;
+	// CRC of the header (address and control fields) and the bytes following it (the HCS)
+	U32 mHeaderCrc;
+	U8 mHcsBytes[ 4 ];
+	U32 mHcsBytesRead;
+	bool mHeaderCrcTaken;
+	U32 mHeaderBytes;
 	
-	vector<U8> mCurrentFrameBytes;
-	vector<U8> mCurrentFrameBytesForHCS;
+	// Sample at the middle of every bit of the current frame, 8 per byte in transmission order
+	// (only kept to locate the single bit errors, up to the length of the syndrome table), and of
+	// the bits of the byte being read. The stuffed bits are not in them.
+	HdlcCrcSyndromeTable mSyndromeTable;
+	vector<U64> mFrameBitSamples;
+	U64 mByteBitSamples[ 8 ];
 	
 	BitState mPreviousBitState;
 	U32 mConsecutiveOnes;
@@ -93,10 +190,48 @@ protected:
 	Frame mAbortFrameToEmit;
 	Frame mEndFlagFrameToEmit;
   bool mFoundEndFlag;
+	
+	// Flags read while hunting for a frame: the fill flags not emitted yet and the last flag
+	U64 mFillFlags;
+	U64 mFillFlagsStart;
+	U64 mFillFlagsEnd;
+	bool mHasLastFlag;
+	HdlcByte mLastFlag;
+	
+	// Field of the compact information field not added to the results yet
+	bool mHasInformationChunk;
+	Frame mInformationChunk;
   
+  // End of the last field added to the results
   U64 mLastFrameEndSample;
-  U8 mLastFrameType;
-  vector<Frame> mResultFrames;
+	
+	// Frame filter: the fields and markers of the frame held while staging, the address (the
+	// bytes of an extended address with the first one as the most significant) and the type of
+	// the frame when they are known, and where the frame starts in the results
+	HdlcFrameFilterState mFrameFilterState;
+	vector<Frame> mStagedFrames;
+	vector<HdlcMarker> mStagedMarkers;
+	U64 mFrameAddress;
+	bool mFrameAddressKnown;
+	HdlcFrameType mFrameType;
+	bool mFrameTypeKnown;
+	bool mFrameCrcError;
+	bool mFilterPending;
+	U64 mStagedFrameStart;
+	U64 mFramePayloadSize;
+	
+	// Repeated frames: the bytes of the last frame shown and of the current one, the repeats
+	// counted so far (from the first field after the frame shown to the end of the last repeat)
+	// and the fields held since the last repeat
+	U8 mRepeatBytes[ HDLC_REPEAT_MAX_BYTES ];
+	U64 mRepeatLength;
+	bool mHasRepeatCandidate;
+	U8 mFrameRepeatBytes[ HDLC_REPEAT_MAX_BYTES ];
+	bool mFrameMayRepeat;
+	U64 mRepeatCount;
+	U64 mRepeatStart;
+	U64 mRepeatEnd;
+	vector<Frame> mHeldFrames;
 	
 	HdlcSimulationDataGenerator mSimulationDataGenerator;
 	bool mSimulationInitilized;
@@ -52,12 +52,35 @@ void HdlcAnalyzerResults::GenBubbleText( U64 frame_index, DisplayBase display_ba
 		case HDLC_ABORT_SEQ:
 			GenAbortFieldString( tabular );
 			break;
+		case HDLC_OVERSIZE_FRAME:
+			GenOversizeFieldString( frame, tabular );
+			break;
+		case HDLC_FILTERED_FRAME:
+			GenFilteredFrameString( frame, display_base, tabular );
+			break;
+		case HDLC_REPEATED_FRAMES:
+			GenRepeatedFramesString( frame, tabular );
+			break;
 
 	}
 }
 
 void HdlcAnalyzerResults::GenFlagFieldString( const Frame & frame, bool tabular ) 
 {
+	if( frame.mData1 == HDLC_FLAG_FILL && frame.mData2 != 0 ) // collapsed fill flags
+	{
+		char countStr[ 32 ];
+		AnalyzerHelpers::GetNumberString( frame.mData2, Decimal, 64, countStr, 32 );
+		if( !tabular ) 
+		{
+			AddResultString( "F" );
+			AddResultString( "FL" );
+			AddResultString( countStr, " FILL FLAGS" );
+		}
+		AddResultString( countStr, " Fill Flag Delimiters" );
+		return;
+	}
+	
 	char* flagTypeStr=0;
 	switch( frame.mData1 )
 	{
@@ -66,14 +89,27 @@ void HdlcAnalyzerResults::GenFlagFieldString( const Frame & frame, bool tabular
 		case HDLC_FLAG_FILL: flagTypeStr = "Fill"; break;
 	}
 	
+	// Stuffed zeros of the frame on its end flag
+	string stuffingStr;
+	if( frame.mData1 == HDLC_FLAG_END && frame.mData2 != 0 && mSettings->mStuffingMarkers == HDLC_STUFFING_COUNT )
+	{
+		stringstream ss;
+		ss << " - " << ( frame.mData2 & 0xFFFFFFFF ) << " STUFFED BITS";
+		stuffingStr = ss.str();
+	}
+	
 	if( !tabular ) 
 	{
 		AddResultString( "F" );
 		AddResultString( "FL" );
 		AddResultString( "FLAG" );
 		AddResultString( flagTypeStr, " FLAG" );
+		if( !stuffingStr.empty() )
+		{
+			AddResultString( flagTypeStr, " FLAG", stuffingStr.c_str() );
+		}
 	}
-	AddResultString( flagTypeStr, " Flag Delimiter" );
+	AddResultString( flagTypeStr, " Flag Delimiter", stuffingStr.c_str() );
 }
 
 string HdlcAnalyzerResults::GenEscapedString( const Frame & frame )
@@ -93,6 +129,29 @@ string HdlcAnalyzerResults::GenEscapedString( const Frame & frame )
 	
 }
 
+// Bytes of a compact information field read from the payload arena (escaped ones with the 0x7D)
+string HdlcAnalyzerResults::GenPayloadString( const Frame & frame, DisplayBase display_base )
+{
+	stringstream ss;
+	U64 bytes = frame.mData2 & 0xFFFFFFFF;
+	for( U64 i=0; i < bytes; ++i )
+	{
+		U64 offset = frame.mData1 + i;
+		char byteStr[ 64 ];
+		AnalyzerHelpers::GetNumberString( mPayload.GetByte( offset ), display_base, 8, byteStr, 64 );
+		if( i > 0 )
+		{
+			ss << " ";
+		}
+		if( mPayload.IsEscaped( offset ) )
+		{
+			ss << "0x7D-";
+		}
+		ss << byteStr;
+	}
+	return ss.str();
+}
+
 void HdlcAnalyzerResults::GenAddressFieldString( const Frame & frame, DisplayBase display_base, bool tabular ) 
 {
 	char addressStr[ 64 ];
@@ -116,6 +175,24 @@ void HdlcAnalyzerResults::GenAddressFieldString( const Frame & frame, DisplayBas
 void HdlcAnalyzerResults::GenInformationFieldString( const Frame & frame, const DisplayBase display_base,
 													bool tabular ) 
 {
+	if( frame.mFlags & HDLC_PAYLOAD_CHUNK )
+	{
+		U64 index = frame.mData2 >> 32;
+		U64 bytes = frame.mData2 & 0xFFFFFFFF;
+		stringstream numbersStr;
+		numbersStr << index << "-" << index + bytes - 1;
+		
+		string payloadStr = GenPayloadString( frame, display_base );
+		
+		if( !tabular ) 
+		{
+			AddResultString( "I" );
+			AddResultString( "I ", numbersStr.str().c_str() );
+			AddResultString( "I ", numbersStr.str().c_str(), " [", payloadStr.c_str(), "]" );
+		}
+		AddResultString( "Info ", numbersStr.str().c_str(), " [", payloadStr.c_str(), "]" );
+		return;
+	}
 	
 	char informationStr[ 64 ];
 	AnalyzerHelpers::GetNumberString( frame.mData1, display_base, 8, informationStr, 64 );
@@ -184,12 +261,14 @@ void HdlcAnalyzerResults::GenFcsFieldString( const Frame & frame, DisplayBase di
     case HDLC_CRC8: fcsBits = 8; crcTypeStr= "8 "; break;
     case HDLC_CRC16: fcsBits = 16; crcTypeStr= "16"; break;
     case HDLC_CRC32: fcsBits = 32; crcTypeStr= "32"; break;
+    case HDLC_FCS16: fcsBits = 16; crcTypeStr= "16"; break;
+    case HDLC_FCS32: fcsBits = 32; crcTypeStr= "32"; break;
   }
   
   char readFcsStr[ 128 ];
   AnalyzerHelpers::GetNumberString( frame.mData1, display_base, fcsBits, readFcsStr, 128 );
   char calcFcsStr[ 128 ];
-  AnalyzerHelpers::GetNumberString( frame.mData2, display_base, fcsBits, calcFcsStr, 128 );
+  AnalyzerHelpers::GetNumberString( frame.mData2 & 0xFFFFFFFF, display_base, fcsBits, calcFcsStr, 128 );
   
   stringstream fieldNameStr;
   if( frame.mFlags & DISPLAY_AS_ERROR_FLAG )
@@ -230,6 +309,12 @@ void HdlcAnalyzerResults::GenFcsFieldString( const Frame & frame, DisplayBase di
   {
     fieldNameStr << " - CALC CRC[" << calcFcsStr << "] != READ CRC[" << readFcsStr << "]";
   }
+  
+  U32 bitErrorPosition = U32( frame.mData2 >> 32 );
+  if( bitErrorPosition != 0 )
+  {
+    fieldNameStr << " - BIT ERROR: BYTE " << ( bitErrorPosition - 1 ) / 8 << " BIT " << ( bitErrorPosition - 1 ) % 8;
+  }
 
   AddResultString( fieldNameStr.str().c_str()  );
   
@@ -255,6 +340,65 @@ void HdlcAnalyzerResults::GenAbortFieldString( bool tabular )
   AddResultString( "ABORT SEQUENCE!", seq );
 }
 
+void HdlcAnalyzerResults::GenOversizeFieldString( const Frame & frame, bool tabular )
+{
+  char maxLengthStr[ 64 ];
+  AnalyzerHelpers::GetNumberString( frame.mData1, Decimal, 32, maxLengthStr, 64 );
+  if( !tabular ) 
+  {
+    AddResultString( "OV!" );
+    AddResultString( "OVERSIZE!" );
+  }
+  AddResultString( "OVERSIZE FRAME! (>", maxLengthStr, " bytes)" );
+}
+
+// Frame left out by the frame filter: its address (the whole extended address) and its length
+void HdlcAnalyzerResults::GenFilteredFrameString( const Frame & frame, DisplayBase display_base, bool tabular )
+{
+  char bytesStr[ 64 ];
+  AnalyzerHelpers::GetNumberString( frame.mData2, Decimal, 32, bytesStr, 64 );
+  string addressStr;
+  if( !( frame.mFlags & HDLC_FILTERED_NO_ADDRESS ) )
+  {
+    addressStr = string( "Address " ) + GenFilteredAddressString( frame, display_base ) + ", ";
+  }
+  if( !tabular ) 
+  {
+    AddResultString( "F" );
+    AddResultString( "FILTERED" );
+  }
+  AddResultString( "Filtered frame (", addressStr.c_str(), bytesStr, " bytes)" );
+}
+
+// Address of a filtered frame, with as many bytes as the address has
+string HdlcAnalyzerResults::GenFilteredAddressString( const Frame & frame, DisplayBase display_base )
+{
+  U32 addressBits = 8;
+  while( addressBits < 64 && ( frame.mData1 >> addressBits ) != 0 )
+  {
+    addressBits += 8;
+  }
+  char numberStr[ 128 ];
+  AnalyzerHelpers::GetNumberString( frame.mData1, display_base, addressBits, numberStr, 128 );
+  return string( numberStr );
+}
+
+// Repeats of the frame shown before (only their number and length are kept)
+void HdlcAnalyzerResults::GenRepeatedFramesString( const Frame & frame, bool tabular )
+{
+  char repeatsStr[ 64 ];
+  AnalyzerHelpers::GetNumberString( frame.mData1, Decimal, 64, repeatsStr, 64 );
+  char bytesStr[ 64 ];
+  AnalyzerHelpers::GetNumberString( frame.mData2, Decimal, 32, bytesStr, 64 );
+  if( !tabular ) 
+  {
+    AddResultString( "R" );
+    AddResultString( "x", repeatsStr );
+    AddResultString( "REPEATED x", repeatsStr );
+  }
+  AddResultString( "Previous frame repeated ", repeatsStr, " times (", bytesStr, " bytes)" );
+}
+
 string HdlcAnalyzerResults::EscapeByteStr( const Frame & frame )
 {
 	if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BYTE_ASYNC && frame.mFlags & HDLC_ESCAPED_BYTE )
@@ -267,8 +411,52 @@ string HdlcAnalyzerResults::EscapeByteStr( const Frame & frame )
 	}
 }
 
-void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase display_base, U32 /*export_type_user_id*/ )
+// Row of the CSV export for a record of repeated frames or a filtered frame
+void HdlcAnalyzerResults::GenSummaryExportRow( ofstream & fileStream, const Frame & frame, DisplayBase display_base, 
+											   U64 triggerSample, U32 sampleRate )
 {
+	char timeStr[ 64 ];
+	AnalyzerHelpers::GetTimeString( frame.mStartingSampleInclusive, triggerSample, sampleRate, timeStr, 64 );
+	char bytesStr[ 64 ];
+	AnalyzerHelpers::GetNumberString( frame.mData2, Decimal, 32, bytesStr, 64 );
+	
+	fileStream << timeStr << ",";
+	if( frame.mType == HDLC_FILTERED_FRAME && !( frame.mFlags & HDLC_FILTERED_NO_ADDRESS ) )
+	{
+		fileStream << GenFilteredAddressString( frame, display_base );
+	}
+	fileStream << ",,";
+	if( mSettings->mWithHcsField )
+	{
+		fileStream << ",";
+	}
+	
+	if( frame.mType == HDLC_REPEATED_FRAMES )
+	{
+		char repeatsStr[ 64 ];
+		AnalyzerHelpers::GetNumberString( frame.mData1, Decimal, 64, repeatsStr, 64 );
+		fileStream << "repeated x" << repeatsStr << " (" << bytesStr << " bytes),";
+	}
+	else
+	{
+		fileStream << "filtered (" << bytesStr << " bytes),";
+	}
+	fileStream << endl;
+}
+
+void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase display_base, U32 export_type_user_id )
+{
+	if( export_type_user_id == HDLC_EXPORT_CRC_STATISTICS )
+	{
+		GenerateCrcStatisticsFile( file );
+		return;
+	}
+	if( export_type_user_id == HDLC_EXPORT_COMMIT_STATISTICS )
+	{
+		GenerateCommitStatisticsFile( file );
+		return;
+	}
+	
 	ofstream fileStream( file, ios::out );
 
 	U64 triggerSample = mAnalyzer->GetTriggerSample();
@@ -282,6 +470,8 @@ void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase disp
 		case HDLC_CRC8: fcsBits = 8; break;
 		case HDLC_CRC16: fcsBits = 16; break;
 		case HDLC_CRC32: fcsBits = 32; break;
+		case HDLC_FCS16: fcsBits = 16; break;
+		case HDLC_FCS32: fcsBits = 32; break;
 	}
 
 	fileStream << "Time[s],Address,Control,";
@@ -329,6 +519,13 @@ void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase disp
 			}
 			else
 			{
+				// The repeated and filtered frames only keep a summary: one row with the note in
+				// the information column (and the address of a filtered frame when it was read)
+				if( firstAddressFrame.mType == HDLC_REPEATED_FRAMES || firstAddressFrame.mType == HDLC_FILTERED_FRAME )
+				{
+					GenSummaryExportRow( fileStream, firstAddressFrame, display_base, triggerSample, sampleRate );
+				}
+				
 				frameNumber++;
 				if( frameNumber >= numFrames ) 
 				{
@@ -365,7 +562,7 @@ void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase disp
 			{
 				
 				// Check for abort
-				if( nextAddress.mType == HDLC_ABORT_SEQ )
+				if( nextAddress.mType == HDLC_ABORT_SEQ || nextAddress.mType == HDLC_OVERSIZE_FRAME )
 				{
 					fileStream << "," << endl;
 					doAbortFrame = true;
@@ -506,7 +703,7 @@ void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase disp
 			Frame infoFrame = GetFrame( frameNumber );
 			
 			// Check for abort
-			if( infoFrame.mType == HDLC_ABORT_SEQ )
+			if( infoFrame.mType == HDLC_ABORT_SEQ || infoFrame.mType == HDLC_OVERSIZE_FRAME )
 			{
 				doAbortFrame = true;
 				fileStream << "," << endl;
@@ -521,7 +718,17 @@ void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase disp
 			}
 			
 			// Check for info byte
-			if( infoFrame.mType == HDLC_FIELD_INFORMATION ) // ERROR
+			if( infoFrame.mType == HDLC_FIELD_INFORMATION && ( infoFrame.mFlags & HDLC_PAYLOAD_CHUNK ) )
+			{
+				fileStream << sepChar << GenPayloadString( infoFrame, display_base );
+				frameNumber++; 
+				if( frameNumber >= numFrames ) 
+				{ 
+					UpdateExportProgressAndCheckForCancel( frameNumber, numFrames );
+					return; 
+				}
+			}
+			else if( infoFrame.mType == HDLC_FIELD_INFORMATION ) // ERROR
 			{
 				char infoByteStr[ 64 ];
 				AnalyzerHelpers::GetNumberString( infoFrame.mData1, display_base, 8, infoByteStr, 64 );
@@ -576,6 +783,132 @@ void HdlcAnalyzerResults::GenerateExportFile( const char* file, DisplayBase disp
 		
 }
 
+void HdlcAnalyzerResults::GenerateCrcStatisticsFile( const char* file )
+{
+	ofstream fileStream( file, ios::out );
+	
+	// [0] FCS, [1] HCS
+	U64 checked[ 2 ] = { 0, 0 };
+	U64 correctable[ 2 ] = { 0, 0 };
+	U64 uncorrectable[ 2 ] = { 0, 0 };
+	
+	// Bit stuffing (from the end flags of the bit sync frames, counted with HDLC_STUFFING_COUNT)
+	U64 stuffedFrames = 0;
+	U64 stuffedBits = 0;
+	U64 maxStuffedBits = 0;
+	U64 frameBytes = 0;
+	
+	// Collapsed repeats (with a correct FCS)
+	U64 repeatedFrames = 0;
+	
+	U64 numFrames = GetNumFrames();
+	for( U64 i=0; i < numFrames; ++i )
+	{
+		Frame frame = GetFrame( i );
+		if( frame.mType == HDLC_FIELD_FLAG && frame.mData1 == HDLC_FLAG_END && frame.mData2 != 0 )
+		{
+			U64 bits = frame.mData2 & 0xFFFFFFFF;
+			stuffedFrames++;
+			stuffedBits += bits;
+			maxStuffedBits = ( bits > maxStuffedBits ) ? bits : maxStuffedBits;
+			frameBytes += frame.mData2 >> 32;
+			continue;
+		}
+		
+		if( frame.mType == HDLC_REPEATED_FRAMES )
+		{
+			repeatedFrames += frame.mData1;
+			checked[ 0 ] += frame.mData1;
+			continue;
+		}
+		
+		if( frame.mType != HDLC_FIELD_FCS && frame.mType != HDLC_FIELD_HCS )
+		{
+			continue;
+		}
+		
+		U32 field = ( frame.mType == HDLC_FIELD_FCS ) ? 0 : 1;
+		checked[ field ]++;
+		if( frame.mFlags & DISPLAY_AS_ERROR_FLAG )
+		{
+			if( frame.mData2 >> 32 )
+			{
+				correctable[ field ]++;
+			}
+			else
+			{
+				uncorrectable[ field ]++;
+			}
+		}
+		
+		if( UpdateExportProgressAndCheckForCancel( i, numFrames ) )
+		{
+			return;
+		}
+	}
+	
+	const char* fieldNames[ 2 ] = { "FCS", "HCS" };
+	fileStream << "Field,Checked,Errors,Single bit errors (correctable),Uncorrectable errors" << endl;
+	for( U32 field=0; field < 2; ++field )
+	{
+		fileStream << fieldNames[ field ] << "," << checked[ field ] << ","
+				   << correctable[ field ] + uncorrectable[ field ] << ","
+				   << correctable[ field ] << "," << uncorrectable[ field ] << endl;
+	}
+	if( !mSettings->mLocateBitErrors )
+	{
+		fileStream << "Single bit errors are not located (\"Locate Single Bit Errors\" is not checked)" << endl;
+	}
+	
+	if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BIT_SYNC && mSettings->mStuffingMarkers != HDLC_STUFFING_COUNT )
+	{
+		fileStream << "Bit stuffing is not counted (\"Bit Stuffing Markers\" is not \"Count per Frame\")" << endl;
+	}
+	else if( mSettings->mTransmissionMode == HDLC_TRANSMISSION_BIT_SYNC )
+	{
+		// Overhead: stuffed bits over the bits of the frames (address to FCS)
+		fileStream << "Bit stuffing,Frames,Stuffed bits,Stuffed bits per frame,Max stuffed bits per frame,Overhead %" << endl;
+		fileStream << "," << stuffedFrames << "," << stuffedBits << ","
+				   << ( ( stuffedFrames == 0 ) ? 0.0 : double( stuffedBits ) / double( stuffedFrames ) ) << ","
+				   << maxStuffedBits << ","
+				   << ( ( frameBytes == 0 ) ? 0.0 : 100.0 * double( stuffedBits ) / double( frameBytes * 8 ) ) << endl;
+	}
+	
+	if( mSettings->mCollapseRepeatedFrames )
+	{
+		fileStream << "Repeated frames (collapsed, counted as checked FCS)," << repeatedFrames << endl;
+	}
+	
+	UpdateExportProgressAndCheckForCancel( numFrames, numFrames );
+}
+
+// Commits of the results by the worker thread (see HdlcCommitScheduler) of the last run
+void HdlcAnalyzerResults::GenerateCommitStatisticsFile( const char* file )
+{
+	ofstream fileStream( file, ios::out );
+	
+	const HdlcCommitScheduler & commits = mAnalyzer->GetCommitScheduler();
+	fileStream << "Result commits,Commits per second" << endl;
+	fileStream << commits.GetCommits() << "," << commits.GetCommitsPerSecond() << endl;
+	
+	UpdateExportProgressAndCheckForCancel( 1, 1 );
+}
+
+U64 HdlcAnalyzerResults::AddPayloadByte( U8 value, bool escaped )
+{
+	return mPayload.Append( value, escaped );
+}
+
+U64 HdlcAnalyzerResults::GetPayloadSize() const
+{
+	return mPayload.GetSize();
+}
+
+void HdlcAnalyzerResults::TruncatePayload( U64 size )
+{
+	mPayload.Truncate( size );
+}
+
 void HdlcAnalyzerResults::GenerateFrameTabularText( U64 frame_index, DisplayBase display_base )
 {
 	GenBubbleText( frame_index, display_base, true );
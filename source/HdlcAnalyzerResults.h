@@ -2,7 +2,9 @@
 #define HDLC_ANALYZER_RESULTS
 
 #include <AnalyzerResults.h>
+#include "HdlcPayloadArena.h"
 #include <string>
+#include <fstream>
 
 using namespace std;
 
@@ -21,6 +23,11 @@ public:
 	virtual void GenerateFrameTabularText( U64 frame_index, DisplayBase display_base );
 	virtual void GeneratePacketTabularText( U64 packet_id, DisplayBase display_base );
 	virtual void GenerateTransactionTabularText( U64 transaction_id, DisplayBase display_base );
+	
+	// Bytes of the compact information fields (HDLC_PAYLOAD_CHUNK), returns the offset of the byte
+	U64 AddPayloadByte( U8 value, bool escaped );
+	U64 GetPayloadSize() const;
+	void TruncatePayload( U64 size );
 
 protected: //functions
 	void GenBubbleText( U64 frame_index, DisplayBase display_base, bool tabular );
@@ -31,13 +38,24 @@ protected: //functions
 	void GenInformationFieldString( const Frame & frame, DisplayBase display_base, bool tabular );
 	void GenFcsFieldString( const Frame & frame, DisplayBase display_base, bool tabular );
 	void GenAbortFieldString( bool tabular );
+	void GenOversizeFieldString( const Frame & frame, bool tabular );
+	void GenFilteredFrameString( const Frame & frame, DisplayBase display_base, bool tabular );
+	void GenRepeatedFramesString( const Frame & frame, bool tabular );
+	string GenFilteredAddressString( const Frame & frame, DisplayBase display_base );
+	void GenSummaryExportRow( ofstream & fileStream, const Frame & frame, DisplayBase display_base, 
+							  U64 triggerSample, U32 sampleRate );
+	
+	void GenerateCrcStatisticsFile( const char* file );
+	void GenerateCommitStatisticsFile( const char* file );
 	
 	string EscapeByteStr( const Frame & frame );
 	string GenEscapedString( const Frame & frame );
+	string GenPayloadString( const Frame & frame, DisplayBase display_base );
 	
 protected:  //vars
 	HdlcAnalyzerSettings* mSettings;
 	HdlcAnalyzer* mAnalyzer;
+	HdlcPayloadArena mPayload;
 };
 
 #endif //HDLC_ANALYZER_RESULTS
@@ -1,15 +1,27 @@
 #include "HdlcAnalyzerSettings.h"
 #include <AnalyzerHelpers.h>
+#include <algorithm>
 
 HdlcAnalyzerSettings::HdlcAnalyzerSettings()
 :	mInputChannel( UNDEFINED_CHANNEL ),
 	mBitRate( 2000000 ),
 	mTransmissionMode( HDLC_TRANSMISSION_BIT_SYNC ),
+	mBitSyncDecoder( HDLC_BIT_SYNC_DECODER_SAMPLING ),
 	mHdlcAddr( HDLC_BASIC_ADDRESS_FIELD ),
 	mHdlcControl( HDLC_BASIC_CONTROL_FIELD ),
 	mHdlcFcs( HDLC_CRC16 ),
 	mSharedZero( false ),
-	mWithHcsField( false )
+	mWithHcsField( false ),
+	mLocateBitErrors( false ),
+	mCollapseFillFlags( false ),
+	mCompactInformationField( false ),
+	mMaxFrameLength( 65536 ),
+	mStuffingMarkers( HDLC_STUFFING_MARKERS ),
+	mAddressFilter( HDLC_ADDRESS_FILTER_OFF ),
+	mFrameTypeFilter( HDLC_FRAME_TYPE_FILTER_ALL ),
+	mFilterCrcErrorsOnly( false ),
+	mFilteredFrames( HDLC_FILTERED_SUMMARY ),
+	mCollapseRepeatedFrames( false )
 {
 	mInputChannelInterface.reset( new AnalyzerSettingInterfaceChannel() );
 	mInputChannelInterface->SetTitleAndTooltip( "HDLC", "Standard HDLC" );
@@ -27,6 +39,15 @@ HdlcAnalyzerSettings::HdlcAnalyzerSettings()
 	mHdlcTransmissionInterface->AddNumber( HDLC_TRANSMISSION_BYTE_ASYNC, "Byte Asynchronous", "Byte asynchronous transmission using byte stuffing (Also known as start/stop mode)" );
 	mHdlcTransmissionInterface->SetNumber( mTransmissionMode );
 	
+	mBitSyncDecoderInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mBitSyncDecoderInterface->SetTitleAndTooltip( "Bit Sync Decoder", "Specify how the bits are recovered in Bit Synchronous mode" );
+	mBitSyncDecoderInterface->AddNumber( HDLC_BIT_SYNC_DECODER_SAMPLING, "Bit Sampling", "Every bit is sampled in the middle of its period" );
+	mBitSyncDecoderInterface->AddNumber( HDLC_BIT_SYNC_DECODER_EDGES, "Edge Intervals", "The bits are counted from the time between edges: "
+										 "a channel read per edge instead of per bit (faster), but a glitch on the line "
+										 "adds bits where the sampling may miss it" );
+	mBitSyncDecoderInterface->AddNumber( HDLC_BIT_SYNC_DECODER_DPLL, "Clock Recovery (DPLL)", "Edge intervals measured with a recovered bit clock (allows 2x oversampling)" );
+	mBitSyncDecoderInterface->SetNumber( mBitSyncDecoder );
+	
 	mHdlcAddrInterface.reset( new AnalyzerSettingInterfaceNumberList() );
 	mHdlcAddrInterface->SetTitleAndTooltip( "Address Field Type", "Specify the address field type of an HDLC frame." );
 	mHdlcAddrInterface->AddNumber( HDLC_BASIC_ADDRESS_FIELD, "Basic", "Basic Address Field (8 bits)" );
@@ -46,6 +67,10 @@ HdlcAnalyzerSettings::HdlcAnalyzerSettings()
 	mHdlcFcsInterface->AddNumber( HDLC_CRC8, "CRC-8", "8-bit Cyclic Redundancy Check" );
 	mHdlcFcsInterface->AddNumber( HDLC_CRC16, "CRC-16-CCITT", "16-bit Cyclic Redundancy Check" );
 	mHdlcFcsInterface->AddNumber( HDLC_CRC32, "CRC-32", "32-bit Cyclic Redundancy Check" );
+	mHdlcFcsInterface->AddNumber( HDLC_FCS16, "FCS-16 (RFC 1662)", "16-bit FCS of PPP and LAPB: reflected CRC-16-CCITT, "
+								  "initialized with ones and complemented" );
+	mHdlcFcsInterface->AddNumber( HDLC_FCS32, "FCS-32 (RFC 1662)", "32-bit FCS of PPP: reflected CRC-32, "
+								  "initialized with ones and complemented" );
 	mHdlcFcsInterface->SetNumber( mHdlcFcs );
 	
 	
@@ -62,18 +87,117 @@ HdlcAnalyzerSettings::HdlcAnalyzerSettings()
 											   "between the opening flag and the Header Check Sequence.");
 	mHdlcWithHcsInterface->SetValue( mWithHcsField );
 	
+	mLocateBitErrorsInterface.reset( new AnalyzerSettingInterfaceBool() );
+	mLocateBitErrorsInterface->SetTitleAndTooltip( "Locate Single Bit Errors", "If checked, the bit whose flip would "
+												   "explain a FCS/HCS error is marked (single bit errors, e.g. line noise). "
+												   "Errors that are not a single bit flip are reported as uncorrectable." );
+	mLocateBitErrorsInterface->SetValue( mLocateBitErrors );
+	
+	mCollapseFillFlagsInterface.reset( new AnalyzerSettingInterfaceBool() );
+	mCollapseFillFlagsInterface->SetTitleAndTooltip( "Collapse Fill Flags", "If checked, the fill flags between "
+													 "two frames are shown as a single field with the number of "
+													 "flags (recommended for lines idling with flags)." );
+	mCollapseFillFlagsInterface->SetValue( mCollapseFillFlags );
+	
+	mCompactInformationFieldInterface.reset( new AnalyzerSettingInterfaceBool() );
+	mCompactInformationFieldInterface->SetTitleAndTooltip( "Compact Information Field", "If checked, the bytes of "
+														   "the information field are shown in fields of up to 64 "
+														   "bytes instead of a field per byte (less memory for long "
+														   "captures)." );
+	mCompactInformationFieldInterface->SetValue( mCompactInformationField );
+	
+	mMaxFrameLengthInterface.reset( new AnalyzerSettingInterfaceInteger() );
+	mMaxFrameLengthInterface->SetTitleAndTooltip( "Maximum Frame Length (Bytes)", "Frames longer than this (address to "
+												  "FCS) are reported as oversize and dropped, and the next flag is "
+												  "searched (e.g. when the closing flag is lost)." );
+	mMaxFrameLengthInterface->SetMax( 100000000 );
+	mMaxFrameLengthInterface->SetMin( 1 );
+	mMaxFrameLengthInterface->SetInteger( mMaxFrameLength );
+	
+	mStuffingMarkersInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mStuffingMarkersInterface->SetTitleAndTooltip( "Bit Stuffing Markers (in Bit Sync)", "Specify how the stuffed "
+												   "zeros are shown (a marker every 5 bits of 0xFF bytes slows down "
+												   "long captures)" );
+	mStuffingMarkersInterface->AddNumber( HDLC_STUFFING_MARKERS, "Marker per Stuffed Bit", "A dot on every stuffed zero" );
+	mStuffingMarkersInterface->AddNumber( HDLC_STUFFING_COUNT, "Count per Frame", "The number of stuffed zeros "
+										  "of the frame is shown on its end flag" );
+	mStuffingMarkersInterface->AddNumber( HDLC_STUFFING_NONE, "None", "The stuffed zeros are not shown" );
+	mStuffingMarkersInterface->SetNumber( mStuffingMarkers );
+	
+	mAddressFilterInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mAddressFilterInterface->SetTitleAndTooltip( "Address Filter", "Specify which frames are shown by address "
+												 "(e.g. the stations of interest on a multidrop line)" );
+	mAddressFilterInterface->AddNumber( HDLC_ADDRESS_FILTER_OFF, "Off", "The frames of all the addresses are shown" );
+	mAddressFilterInterface->AddNumber( HDLC_ADDRESS_FILTER_ALLOW, "Only the Listed Addresses", "Only the frames "
+										"with one of the listed addresses are shown" );
+	mAddressFilterInterface->AddNumber( HDLC_ADDRESS_FILTER_DENY, "All but the Listed Addresses", "The frames "
+										"with one of the listed addresses are not shown" );
+	mAddressFilterInterface->SetNumber( mAddressFilter );
+	
+	mAddressFilterListInterface.reset( new AnalyzerSettingInterfaceText() );
+	mAddressFilterListInterface->SetTitleAndTooltip( "Filter Addresses", "Addresses of the address filter, separated "
+													 "by commas (e.g. 0x03, 1). The bytes of an extended address "
+													 "make a single number of up to 8 bytes, the first byte being "
+													 "the most significant (e.g. 0x0381)." );
+	mAddressFilterListInterface->SetText( mAddressFilterList.c_str() );
+	
+	mFrameTypeFilterInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mFrameTypeFilterInterface->SetTitleAndTooltip( "Frame Type Filter", "Specify which frames are shown by type" );
+	mFrameTypeFilterInterface->AddNumber( HDLC_FRAME_TYPE_FILTER_ALL, "All", "The frames of all the types are shown" );
+	mFrameTypeFilterInterface->AddNumber( HDLC_FRAME_TYPE_FILTER_I, "I-Frames", "Only the information frames are shown" );
+	mFrameTypeFilterInterface->AddNumber( HDLC_FRAME_TYPE_FILTER_S, "S-Frames", "Only the supervisory frames are shown" );
+	mFrameTypeFilterInterface->AddNumber( HDLC_FRAME_TYPE_FILTER_U, "U-Frames", "Only the unnumbered frames are shown" );
+	mFrameTypeFilterInterface->SetNumber( mFrameTypeFilter );
+	
+	mFilterCrcErrorsOnlyInterface.reset( new AnalyzerSettingInterfaceBool() );
+	mFilterCrcErrorsOnlyInterface->SetTitleAndTooltip( "Only Frames with CRC Errors", "If checked, only the frames "
+													   "with a wrong FCS or HCS are shown" );
+	mFilterCrcErrorsOnlyInterface->SetValue( mFilterCrcErrorsOnly );
+	
+	mFilteredFramesInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mFilteredFramesInterface->SetTitleAndTooltip( "Filtered Frames", "Specify how the frames left out by the "
+												  "filters are shown" );
+	mFilteredFramesInterface->AddNumber( HDLC_FILTERED_SUMMARY, "Summary Field", "A single field with the address "
+										 "and the length of the frame" );
+	mFilteredFramesInterface->AddNumber( HDLC_FILTERED_HIDDEN, "Hidden", "Nothing is shown (the least memory)" );
+	mFilteredFramesInterface->SetNumber( mFilteredFrames );
+	
+	mCollapseRepeatedFramesInterface.reset( new AnalyzerSettingInterfaceBool() );
+	mCollapseRepeatedFramesInterface->SetTitleAndTooltip( "Collapse Repeated Frames", "If checked, the frames "
+														  "identical to the frame before (e.g. the RR frames of an "
+														  "idle link) are counted in a single field instead of being "
+														  "shown. The first one is always shown. Frames of up to 64 "
+														  "bytes with a correct FCS." );
+	mCollapseRepeatedFramesInterface->SetValue( mCollapseRepeatedFrames );
+	
 	AddInterface( mInputChannelInterface.get() );
 	AddInterface( mBitRateInterface.get() );
 	AddInterface( mHdlcTransmissionInterface.get() );
+	AddInterface( mBitSyncDecoderInterface.get() );
 	AddInterface( mHdlcAddrInterface.get() );
 	AddInterface( mHdlcControlInterface.get() );
 	AddInterface( mHdlcFcsInterface.get() );
 	AddInterface( mHdlcSharedZeroInterface.get() );
 	AddInterface( mHdlcWithHcsInterface.get() );
+	AddInterface( mLocateBitErrorsInterface.get() );
+	AddInterface( mCollapseFillFlagsInterface.get() );
+	AddInterface( mCompactInformationFieldInterface.get() );
+	AddInterface( mMaxFrameLengthInterface.get() );
+	AddInterface( mStuffingMarkersInterface.get() );
+	AddInterface( mAddressFilterInterface.get() );
+	AddInterface( mAddressFilterListInterface.get() );
+	AddInterface( mFrameTypeFilterInterface.get() );
+	AddInterface( mFilterCrcErrorsOnlyInterface.get() );
+	AddInterface( mFilteredFramesInterface.get() );
+	AddInterface( mCollapseRepeatedFramesInterface.get() );
 	
-	AddExportOption( 0, "Export as text/csv file" );
-	AddExportExtension( 0, "text", "txt" );
-	AddExportExtension( 0, "csv", "csv" );
+	AddExportOption( HDLC_EXPORT_CSV, "Export as text/csv file" );
+	AddExportExtension( HDLC_EXPORT_CSV, "text", "txt" );
+	AddExportExtension( HDLC_EXPORT_CSV, "csv", "csv" );
+	AddExportOption( HDLC_EXPORT_CRC_STATISTICS, "Export CRC error and bit stuffing statistics" );
+	AddExportExtension( HDLC_EXPORT_CRC_STATISTICS, "text", "txt" );
+	AddExportOption( HDLC_EXPORT_COMMIT_STATISTICS, "Export result commit statistics" );
+	AddExportExtension( HDLC_EXPORT_COMMIT_STATISTICS, "text", "txt" );
 
 	ClearChannels();
 	AddChannel( mInputChannel, "HDLC", false );
@@ -88,16 +212,117 @@ U8 HdlcAnalyzerSettings::Bit5Inv( U8 value )
 	return value ^ 0x20;
 }
 
+bool HdlcAnalyzerSettings::ParseAddressList( const char* text, std::vector<U64> & addresses )
+{
+	addresses.clear();
+	const char* p = text;
+	for( ; ; )
+	{
+		while( *p == ',' || *p == ';' || *p == ' ' || *p == '\t' )
+		{
+			p++;
+		}
+		if( *p == 0 )
+		{
+			break;
+		}
+		
+		U64 base = 10;
+		if( p[ 0 ] == '0' && ( p[ 1 ] == 'x' || p[ 1 ] == 'X' ) )
+		{
+			base = 16;
+			p += 2;
+		}
+		U64 address = 0;
+		U32 digits = 0;
+		for( ; ; ++p, ++digits )
+		{
+			U64 digit;
+			if( *p >= '0' && *p <= '9' )
+			{
+				digit = *p - '0';
+			}
+			else if( base == 16 && *p >= 'a' && *p <= 'f' )
+			{
+				digit = *p - 'a' + 10;
+			}
+			else if( base == 16 && *p >= 'A' && *p <= 'F' )
+			{
+				digit = *p - 'A' + 10;
+			}
+			else
+			{
+				break;
+			}
+			if( address > ( 0xFFFFFFFFFFFFFFFFull - digit ) / base )
+			{
+				return false;
+			}
+			address = address * base + digit;
+		}
+		if( digits == 0 || ( *p != 0 && *p != ',' && *p != ';' && *p != ' ' && *p != '\t' ) )
+		{
+			return false;
+		}
+		addresses.push_back( address );
+	}
+	
+	std::sort( addresses.begin(), addresses.end() );
+	return true;
+}
+
+bool HdlcAnalyzerSettings::AddressesFit( const std::vector<U64> & addresses ) const
+{
+	return mHdlcAddr != HDLC_BASIC_ADDRESS_FIELD || addresses.empty() || addresses.back() <= 0xFF;
+}
+
+bool HdlcAnalyzerSettings::FilterFrames() const
+{
+	return mAddressFilter != HDLC_ADDRESS_FILTER_OFF || mFrameTypeFilter != HDLC_FRAME_TYPE_FILTER_ALL ||
+		   mFilterCrcErrorsOnly;
+}
+
 bool HdlcAnalyzerSettings::SetSettingsFromInterfaces()
 {
 	mInputChannel = mInputChannelInterface->GetChannel();
 	mBitRate = mBitRateInterface->GetInteger();
 	mTransmissionMode = HdlcTransmissionModeType( U32( mHdlcTransmissionInterface->GetNumber() ) );
+	mBitSyncDecoder = HdlcBitSyncDecoderType( U32( mBitSyncDecoderInterface->GetNumber() ) );
 	mHdlcAddr = HdlcAddressType( U32( mHdlcAddrInterface->GetNumber() ) );
 	mHdlcControl = HdlcControlType( U32( mHdlcControlInterface->GetNumber() ) );
 	mHdlcFcs = HdlcFcsType( U32( mHdlcFcsInterface->GetNumber() ) );
 	mSharedZero = mHdlcSharedZeroInterface->GetValue();
 	mWithHcsField = mHdlcWithHcsInterface->GetValue();
+	mLocateBitErrors = mLocateBitErrorsInterface->GetValue();
+	mCollapseFillFlags = mCollapseFillFlagsInterface->GetValue();
+	mCompactInformationField = mCompactInformationFieldInterface->GetValue();
+	mMaxFrameLength = mMaxFrameLengthInterface->GetInteger();
+	mStuffingMarkers = HdlcStuffingMarkersType( U32( mStuffingMarkersInterface->GetNumber() ) );
+	
+	HdlcAddressFilterType addressFilter = HdlcAddressFilterType( U32( mAddressFilterInterface->GetNumber() ) );
+	std::vector<U64> filterAddresses;
+	if( !ParseAddressList( mAddressFilterListInterface->GetText(), filterAddresses ) )
+	{
+		SetErrorText( "Invalid filter addresses: use numbers of up to 8 bytes separated by commas (e.g. 0x03, 1)" );
+		return false;
+	}
+	if( !AddressesFit( filterAddresses ) )
+	{
+		SetErrorText( "Invalid filter addresses: a basic address field is a single byte (0 to 0xFF)" );
+		return false;
+	}
+	if( addressFilter != HDLC_ADDRESS_FILTER_OFF && filterAddresses.empty() )
+	{
+		SetErrorText( "The address filter needs at least one address" );
+		return false;
+	}
+	mAddressFilter = addressFilter;
+	mAddressFilterList = mAddressFilterListInterface->GetText();
+	mFilterAddresses = filterAddresses;
+	mFrameTypeFilter = HdlcFrameTypeFilterType( U32( mFrameTypeFilterInterface->GetNumber() ) );
+	mFilterCrcErrorsOnly = mFilterCrcErrorsOnlyInterface->GetValue();
+	mFilteredFrames = HdlcFilteredFramesType( U32( mFilteredFramesInterface->GetNumber() ) );
+	mCollapseRepeatedFrames = mCollapseRepeatedFramesInterface->GetValue();
 	
 	ClearChannels();
 	AddChannel( mInputChannel, "HDLC", true );
@@ -110,11 +335,23 @@ void HdlcAnalyzerSettings::UpdateInterfacesFromSettings()
 	mInputChannelInterface->SetChannel( mInputChannel );
 	mBitRateInterface->SetInteger( mBitRate );
 	mHdlcTransmissionInterface->SetNumber( mTransmissionMode );
+	mBitSyncDecoderInterface->SetNumber( mBitSyncDecoder );
 	mHdlcAddrInterface->SetNumber( mHdlcAddr );
 	mHdlcControlInterface->SetNumber( mHdlcControl );
 	mHdlcFcsInterface->SetNumber( mHdlcFcs );
 	mHdlcSharedZeroInterface->SetValue( mSharedZero );
 	mHdlcWithHcsInterface->SetValue( mWithHcsField );
+	mLocateBitErrorsInterface->SetValue( mLocateBitErrors );
+	mCollapseFillFlagsInterface->SetValue( mCollapseFillFlags );
+	mCompactInformationFieldInterface->SetValue( mCompactInformationField );
+	mMaxFrameLengthInterface->SetInteger( mMaxFrameLength );
+	mStuffingMarkersInterface->SetNumber( mStuffingMarkers );
+	mAddressFilterInterface->SetNumber( mAddressFilter );
+	mAddressFilterListInterface->SetText( mAddressFilterList.c_str() );
+	mFrameTypeFilterInterface->SetNumber( mFrameTypeFilter );
+	mFilterCrcErrorsOnlyInterface->SetValue( mFilterCrcErrorsOnly );
+	mFilteredFramesInterface->SetNumber( mFilteredFrames );
+	mCollapseRepeatedFramesInterface->SetValue( mCollapseRepeatedFrames );
 }
 
 void HdlcAnalyzerSettings::LoadSettings( const char* settings )
@@ -130,6 +367,25 @@ void HdlcAnalyzerSettings::LoadSettings( const char* settings )
 	text_archive >> *( U32* ) &mHdlcFcs;
 	text_archive >> mSharedZero;
 	text_archive >> mWithHcsField;
+	text_archive >> mLocateBitErrors;
+	text_archive >> *( U32* ) &mBitSyncDecoder;
+	text_archive >> mCollapseFillFlags;
+	text_archive >> mCompactInformationField;
+	text_archive >> mMaxFrameLength;
+	text_archive >> *( U32* ) &mStuffingMarkers;
+	text_archive >> *( U32* ) &mAddressFilter;
+	const char* addressFilterList = "";
+	text_archive >> &addressFilterList;
+	mAddressFilterList = addressFilterList;
+	if( !ParseAddressList( addressFilterList, mFilterAddresses ) || !AddressesFit( mFilterAddresses ) )
+	{
+		mFilterAddresses.clear();
+		mAddressFilter = HDLC_ADDRESS_FILTER_OFF;
+	}
+	text_archive >> *( U32* ) &mFrameTypeFilter;
+	text_archive >> mFilterCrcErrorsOnly;
+	text_archive >> *( U32* ) &mFilteredFrames;
+	text_archive >> mCollapseRepeatedFrames;
 
 	ClearChannels();
 	AddChannel( mInputChannel, "HDLC", true );
@@ -149,6 +405,18 @@ const char* HdlcAnalyzerSettings::SaveSettings()
 	text_archive << U32( mHdlcFcs );
 	text_archive << mSharedZero;
 	text_archive << mWithHcsField;
+	text_archive << mLocateBitErrors;
+	text_archive << U32( mBitSyncDecoder );
+	text_archive << mCollapseFillFlags;
+	text_archive << mCompactInformationField;
+	text_archive << mMaxFrameLength;
+	text_archive << U32( mStuffingMarkers );
+	text_archive << U32( mAddressFilter );
+	text_archive << mAddressFilterList.c_str();
+	text_archive << U32( mFrameTypeFilter );
+	text_archive << mFilterCrcErrorsOnly;
+	text_archive << U32( mFilteredFrames );
+	text_archive << mCollapseRepeatedFrames;
 
 	return SetReturnString( text_archive.GetString() );
 }
@@ -3,6 +3,7 @@
 
 #include <AnalyzerSettings.h>
 #include <AnalyzerTypes.h>
+#include <vector>
 
 /////////////////////////////////////
 
@@ -14,9 +15,12 @@
 // Inner frames types of HDLC frame (address, control, data, fcs, etc)
 enum HdlcFieldType { HDLC_FIELD_FLAG = 0, HDLC_FIELD_BASIC_ADDRESS, HDLC_FIELD_EXTENDED_ADDRESS, 
 					 HDLC_FIELD_BASIC_CONTROL, HDLC_FIELD_EXTENDED_CONTROL, 
-					 HDLC_FIELD_INFORMATION, HDLC_FIELD_FCS, HDLC_ABORT_SEQ, HDLC_FIELD_HCS };
+					 HDLC_FIELD_INFORMATION, HDLC_FIELD_FCS, HDLC_ABORT_SEQ, HDLC_FIELD_HCS, 
+					 HDLC_OVERSIZE_FRAME, HDLC_FILTERED_FRAME, HDLC_REPEATED_FRAMES };
 // Transmission mode (bit stuffing or byte stuffing)
 enum HdlcTransmissionModeType { HDLC_TRANSMISSION_BIT_SYNC = 0, HDLC_TRANSMISSION_BYTE_ASYNC };
+// Decoder of the bit synchronous transmission
+enum HdlcBitSyncDecoderType { HDLC_BIT_SYNC_DECODER_SAMPLING = 0, HDLC_BIT_SYNC_DECODER_EDGES, HDLC_BIT_SYNC_DECODER_DPLL };
 // Types of HDLC frames (Information, Supervisory and Unnumbered)
 enum HdlcFrameType { HDLC_I_FRAME = 0, HDLC_S_FRAME = 1, HDLC_U_FRAME = 3 };
 // Address Field type
@@ -27,10 +31,22 @@ enum HdlcControlType { HDLC_BASIC_CONTROL_FIELD,
 					   HDLC_EXTENDED_CONTROL_FIELD_MOD_32768, 
 					   HDLC_EXTENDED_CONTROL_FIELD_MOD_2147483648 };
 // Frame Check Sequence algorithm
-enum HdlcFcsType { HDLC_CRC8 = 0, HDLC_CRC16 = 1, HDLC_CRC32 = 2 };
+enum HdlcFcsType { HDLC_CRC8 = 0, HDLC_CRC16 = 1, HDLC_CRC32 = 2, HDLC_FCS16 = 3, HDLC_FCS32 = 4 };
 enum HdlcCrcField { HDLC_CRC_HCS = 0, HDLC_CRC_FCS };
-// Flag Field Type (Start, End or Fill)
+// Export options
+enum HdlcExportType { HDLC_EXPORT_CSV = 0, HDLC_EXPORT_CRC_STATISTICS, HDLC_EXPORT_COMMIT_STATISTICS };
+// Flag Field Type (Start, End or Fill). With HDLC_STUFFING_COUNT, mData2 of the end flag of a bit
+// sync frame has the number of stuffed zeros of the frame (32 lsb) and the bytes of the frame (32 msb).
 enum HdlcFlagType { HDLC_FLAG_START = 0, HDLC_FLAG_END = 1, HDLC_FLAG_FILL = 2 };
+// Stuffed zeros of the bit synchronous transmission: a marker each, their number on the end flag
+// of the frame, or nothing
+enum HdlcStuffingMarkersType { HDLC_STUFFING_MARKERS = 0, HDLC_STUFFING_COUNT, HDLC_STUFFING_NONE };
+// Frame filter: the frames with (or without) the listed addresses, of a frame type and/or with a
+// FCS/HCS error are shown, the others are shown as a summary field or not at all
+enum HdlcAddressFilterType { HDLC_ADDRESS_FILTER_OFF = 0, HDLC_ADDRESS_FILTER_ALLOW, HDLC_ADDRESS_FILTER_DENY };
+enum HdlcFrameTypeFilterType { HDLC_FRAME_TYPE_FILTER_ALL = 0, HDLC_FRAME_TYPE_FILTER_I, 
+							   HDLC_FRAME_TYPE_FILTER_S, HDLC_FRAME_TYPE_FILTER_U };
+enum HdlcFilteredFramesType { HDLC_FILTERED_SUMMARY = 0, HDLC_FILTERED_HIDDEN };
 
 
 // Special values for Byte Asynchronous Transmission
@@ -39,6 +55,14 @@ enum HdlcFlagType { HDLC_FLAG_START = 0, HDLC_FLAG_END = 1, HDLC_FLAG_FILL = 2 }
 #define HDLC_FILL_VALUE 0xFF
 // For Frame::mFlag
 #define HDLC_ESCAPED_BYTE ( 1 << 0 )
+// Information field of several bytes in the payload arena of the results: mData1 is the offset
+// of the first byte, mData2 the number of bytes (32 lsb) and the index of the first byte in the
+// information field (32 msb)
+#define HDLC_PAYLOAD_CHUNK ( 1 << 1 )
+// Summary field of a filtered frame (HDLC_FILTERED_FRAME): mData1 is the address and mData2 the
+// bytes of the frame, the flag tells that the frame ended before the address was complete (or
+// that the extended address was longer than 8 bytes)
+#define HDLC_FILTERED_NO_ADDRESS ( 1 << 2 )
 
 /////////////////////////////////////
 
@@ -54,26 +78,58 @@ public:
 	virtual const char* SaveSettings();
 	
 	static U8 Bit5Inv( U8 value );
+	// Addresses separated by commas or spaces, decimal or hexadecimal (0x), sorted. False if the
+	// text isn't a list of numbers or a number doesn't fit in 64 bits
+	static bool ParseAddressList( const char* text, std::vector<U64> & addresses );
+	// The addresses (sorted) fit in the address field: a byte for the basic address field, up to
+	// 8 bytes for the extended one
+	bool AddressesFit( const std::vector<U64> & addresses ) const;
+	bool FilterFrames() const;
 
 	Channel mInputChannel;
 	U32 mBitRate;
 
 	HdlcTransmissionModeType mTransmissionMode;
+	HdlcBitSyncDecoderType mBitSyncDecoder;
 	HdlcAddressType mHdlcAddr;
 	HdlcControlType mHdlcControl;	
 	HdlcFcsType mHdlcFcs;
 	bool mSharedZero;
 	bool mWithHcsField;	
+	bool mLocateBitErrors;
+	bool mCollapseFillFlags;
+	bool mCompactInformationField;
+	U32 mMaxFrameLength;
+	HdlcStuffingMarkersType mStuffingMarkers;
+	HdlcAddressFilterType mAddressFilter;
+	std::string mAddressFilterList;
+	std::vector<U64> mFilterAddresses;
+	HdlcFrameTypeFilterType mFrameTypeFilter;
+	bool mFilterCrcErrorsOnly;
+	HdlcFilteredFramesType mFilteredFrames;
+	bool mCollapseRepeatedFrames;
 	
 protected:
 	std::auto_ptr< AnalyzerSettingInterfaceChannel >	mInputChannelInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceInteger >	mBitRateInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mHdlcAddrInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mHdlcTransmissionInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mBitSyncDecoderInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mHdlcControlInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mHdlcFcsInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceBool > mHdlcSharedZeroInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceBool > mHdlcWithHcsInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceBool > mLocateBitErrorsInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceBool > mCollapseFillFlagsInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceBool > mCompactInformationFieldInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceInteger > mMaxFrameLengthInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mStuffingMarkersInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mAddressFilterInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceText > mAddressFilterListInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mFrameTypeFilterInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceBool > mFilterCrcErrorsOnlyInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mFilteredFramesInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceBool > mCollapseRepeatedFramesInterface;
 
 };
 
@@ -0,0 +1,212 @@
+#include "HdlcBitSyncDecoder.h"
+
+// Intervals of 8 or more bit periods are all the same: an abort sequence or an idle line
+#define HDLC_BIT_SYNC_MAX_INTERVAL_BITS 8
+#define HDLC_BIT_SYNC_FLAG_INTERVAL_BITS 7
+#define HDLC_BIT_SYNC_STUFFING_INTERVAL_BITS 6
+
+// DPLL loop gains (as shifts). The phase moves 1/2 of the phase error after locking, and less
+// every time the number of edges doubles, down to 1/64: fast locking at the start of a frame,
+// then the quantization of the edges is averaged. The bit period moves 1/1024 of the error per
+// bit and stays within 1/8 of the nominal one.
+#define HDLC_DPLL_MAX_PHASE_SHIFT 6
+#define HDLC_DPLL_FREQUENCY_SHIFT 10
+#define HDLC_DPLL_FREQUENCY_RANGE_SHIFT 3
+
+HdlcBitSyncDecoder::HdlcBitSyncDecoder()
+:	mChannel( 0 ),
+	mSamplesPerBit( 1 << 16 ),
+	mNominalSamplesPerBit( 1 << 16 ),
+	mRecoverClock( false ),
+	mClockLocked( false ),
+	mClockPhase( 0 ),
+	mPhaseShift( 1 ),
+	mPhaseEdges( 0 ),
+	mIntervalStart( 0 ),
+	mIntervalEnd( 0 ),
+	mIntervalBits( 0 ),
+	mLastIntervalLength( 0 ),
+	mLastIntervalBits( 0 ),
+	mNextBit( 0 ),
+	mFlagZero( false ),
+	mStuffedZero( false ),
+	mHasUnread( false )
+{
+}
+
+void HdlcBitSyncDecoder::Setup( AnalyzerChannelData* channel, U32 sampleRateHz, U32 bitRate, bool recoverClock )
+{
+	mChannel = channel;
+	mSamplesPerBit = ( U64( sampleRateHz ) << 16 ) / bitRate;
+	mNominalSamplesPerBit = mSamplesPerBit;
+	mRecoverClock = recoverClock;
+	mClockLocked = false;
+	mClockPhase = 0;
+	mPhaseShift = 1;
+	mPhaseEdges = 0;
+	mIntervalStart = mChannel->GetSampleNumber();
+	mIntervalEnd = mIntervalStart;
+	mIntervalBits = 0;
+	mLastIntervalLength = 0;
+	mLastIntervalBits = 0;
+	mNextBit = 0;
+	mFlagZero = false;
+	mStuffedZero = false;
+	mHasUnread = false;
+}
+
+void HdlcBitSyncDecoder::ReadInterval()
+{
+	U32 previousBits = mIntervalBits;
+
+	mIntervalStart = mIntervalEnd;
+	mChannel->AdvanceToNextEdge();
+	mIntervalEnd = mChannel->GetSampleNumber();
+
+	if( mRecoverClock )
+	{
+		mIntervalBits = RecoverClock();
+	}
+	else
+	{
+		// Flag fill repeats the same interval, only a new length needs the division
+		U64 length = mIntervalEnd - mIntervalStart;
+		if( length != mLastIntervalLength || mLastIntervalBits == 0 )
+		{
+			U64 bits = ( ( length << 16 ) + mSamplesPerBit / 2 ) / mSamplesPerBit;
+			if( bits == 0 ) // glitch
+			{
+				bits = 1;
+			}
+			mLastIntervalLength = length;
+			mLastIntervalBits = ( bits > HDLC_BIT_SYNC_MAX_INTERVAL_BITS ) ? HDLC_BIT_SYNC_MAX_INTERVAL_BITS : U32( bits );
+		}
+		mIntervalBits = mLastIntervalBits;
+	}
+	mFlagZero = ( previousBits == HDLC_BIT_SYNC_FLAG_INTERVAL_BITS );
+	mStuffedZero = ( previousBits == HDLC_BIT_SYNC_STUFFING_INTERVAL_BITS );
+
+	// The 0 after a flag is its last one (shared zero): a one bit interval has nothing left
+	mNextBit = mFlagZero ? 1 : 0;
+}
+
+// Bits of the interval ending at the new edge, counted from the recovered clock. The clock
+// is corrected with the phase error of the edge (proportional-integral loop). The frequency is
+// kept from frame to frame, only the phase is set again after an idle line.
+U32 HdlcBitSyncDecoder::RecoverClock()
+{
+	U64 edge = mIntervalEnd << 16;
+	if( !mClockLocked )
+	{
+		LockClock( edge );
+		return HDLC_BIT_SYNC_MAX_INTERVAL_BITS;
+	}
+
+	S64 elapsed = S64( edge - mClockPhase );
+	U64 bits = ( elapsed <= 0 ) ? 0 : ( U64( elapsed ) + mSamplesPerBit / 2 ) / mSamplesPerBit;
+	if( bits == 0 ) // glitch
+	{
+		return 1;
+	}
+	if( bits >= HDLC_BIT_SYNC_MAX_INTERVAL_BITS )
+	{
+		// Abort or idle line: too long to tell a frequency error from a missing bit
+		LockClock( edge );
+		return HDLC_BIT_SYNC_MAX_INTERVAL_BITS;
+	}
+
+	S64 error = elapsed - S64( bits * mSamplesPerBit );
+	mClockPhase += bits * mSamplesPerBit + error / ( 1 << mPhaseShift );
+	if( mPhaseShift < HDLC_DPLL_MAX_PHASE_SHIFT && ++mPhaseEdges >= ( 1U << mPhaseShift ) )
+	{
+		mPhaseShift++;
+		mPhaseEdges = 0;
+	}
+
+	S64 period = S64( mSamplesPerBit ) + error / S64( bits << HDLC_DPLL_FREQUENCY_SHIFT );
+	S64 range = S64( mNominalSamplesPerBit >> HDLC_DPLL_FREQUENCY_RANGE_SHIFT );
+	if( period < S64( mNominalSamplesPerBit ) - range )
+	{
+		period = S64( mNominalSamplesPerBit ) - range;
+	}
+	else if( period > S64( mNominalSamplesPerBit ) + range )
+	{
+		period = S64( mNominalSamplesPerBit ) + range;
+	}
+	mSamplesPerBit = U64( period );
+
+	return U32( bits );
+}
+
+void HdlcBitSyncDecoder::LockClock( U64 edge )
+{
+	mClockLocked = true;
+	mClockPhase = edge;
+	mPhaseShift = 1;
+	mPhaseEdges = 0;
+}
+
+// First sample of a bit of the current interval. The interval is split in equal bits, so the
+// error of the bit period doesn't accumulate from edge to edge.
+U64 HdlcBitSyncDecoder::BitSample( U32 bit ) const
+{
+	if( mIntervalBits == HDLC_BIT_SYNC_MAX_INTERVAL_BITS )
+	{
+		return mIntervalStart + ( ( bit * mSamplesPerBit ) >> 16 );
+	}
+	return mIntervalStart + ( mIntervalEnd - mIntervalStart ) * bit / mIntervalBits;
+}
+
+HdlcBitSyncItem HdlcBitSyncDecoder::CreateItem( HdlcBitSyncItemType type, BitState bit, U64 startSample, U64 endSample ) const
+{
+	HdlcBitSyncItem item = { type, bit, startSample, endSample };
+	return item;
+}
+
+HdlcBitSyncItem HdlcBitSyncDecoder::Next()
+{
+	if( mHasUnread )
+	{
+		mHasUnread = false;
+		return mUnread;
+	}
+
+	while( mNextBit >= mIntervalBits )
+	{
+		ReadInterval();
+	}
+
+	if( mIntervalBits == HDLC_BIT_SYNC_FLAG_INTERVAL_BITS )
+	{
+		// Also if its 0 is the last one of the previous flag (shared zero)
+		mNextBit = mIntervalBits;
+		return CreateItem( HDLC_BIT_SYNC_FLAG, BIT_LOW, mIntervalStart, mIntervalEnd );
+	}
+
+	U32 bit = mNextBit++;
+	if( bit == 0 )
+	{
+		HdlcBitSyncItemType type = mStuffedZero ? HDLC_BIT_SYNC_STUFFED_BIT : HDLC_BIT_SYNC_DATA_BIT;
+		return CreateItem( type, BIT_LOW, BitSample( 0 ), BitSample( 1 ) );
+	}
+
+	if( mIntervalBits == HDLC_BIT_SYNC_MAX_INTERVAL_BITS )
+	{
+		// The 7 ones after the 0
+		mNextBit = mIntervalBits;
+		return CreateItem( HDLC_BIT_SYNC_ABORT, BIT_HIGH, BitSample( 1 ), BitSample( 8 ) );
+	}
+
+	return CreateItem( HDLC_BIT_SYNC_DATA_BIT, BIT_HIGH, BitSample( bit ), BitSample( bit + 1 ) );
+}
+
+void HdlcBitSyncDecoder::Unread( const HdlcBitSyncItem & item )
+{
+	mUnread = item;
+	mHasUnread = true;
+}
+
+bool HdlcBitSyncDecoder::NeedsEdge() const
+{
+	return !mHasUnread && mNextBit >= mIntervalBits;
+}
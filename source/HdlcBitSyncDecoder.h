@@ -0,0 +1,83 @@
+#ifndef HDLC_BIT_SYNC_DECODER
+#define HDLC_BIT_SYNC_DECODER
+
+#include <AnalyzerChannelData.h>
+
+// What the bit synchronous decoder found next in the stream
+enum HdlcBitSyncItemType { HDLC_BIT_SYNC_DATA_BIT = 0, HDLC_BIT_SYNC_STUFFED_BIT, HDLC_BIT_SYNC_FLAG, HDLC_BIT_SYNC_ABORT };
+
+struct HdlcBitSyncItem
+{
+	HdlcBitSyncItemType type;
+	BitState bit;
+	U64 startSample;
+	U64 endSample;
+};
+
+// Edge interval decoder of the bit synchronous transmission (NRZI, 0 == transition).
+// An interval of N bit periods between two edges is a 0 followed by N-1 ones, so the
+// destuffing and the flag/abort detection are done on whole intervals:
+//   N <= 5: data bits
+//   N == 6: data bits, and the 0 of the next edge is a stuffed bit
+//   N == 7: flag (the 0, six ones and the 0 of the next edge)
+//   N >= 8: the 0 and an abort sequence (7 or more ones), or an idle line
+// It takes one AdvanceToNextEdge per interval instead of sampling every bit.
+// With the clock recovery (DPLL) the intervals are measured from the recovered bit clock
+// instead of the previous edge: its phase and frequency follow the edges of the frames, so
+// the quantization of the edges doesn't add up and the decoding works down to 2 samples per bit.
+class HdlcBitSyncDecoder
+{
+public:
+	HdlcBitSyncDecoder();
+
+	// Starts decoding at the current position of the channel
+	void Setup( AnalyzerChannelData* channel, U32 sampleRateHz, U32 bitRate, bool recoverClock );
+
+	HdlcBitSyncItem Next();
+	// The next call to Next() returns this item again
+	void Unread( const HdlcBitSyncItem & item );
+	// The next call to Next() reads an edge (and may wait for it)
+	bool NeedsEdge() const;
+	// Reads the next edge. Next() reads the edges it needs itself, this lets the caller do
+	// something before each read while NeedsEdge() (a one bit interval can need another one).
+	void ReadInterval();
+
+protected:
+	U32 RecoverClock();
+	void LockClock( U64 edge );
+	U64 BitSample( U32 bit ) const;
+	HdlcBitSyncItem CreateItem( HdlcBitSyncItemType type, BitState bit, U64 startSample, U64 endSample ) const;
+
+	AnalyzerChannelData* mChannel;
+	// Bit period in 1/65536 samples (tracked by the DPLL)
+	U64 mSamplesPerBit;
+	U64 mNominalSamplesPerBit;
+
+	// DPLL: bit boundary of the last edge in 1/65536 samples. It's not locked until the first
+	// edge and after an idle line, there the next edge sets the phase
+	bool mRecoverClock;
+	bool mClockLocked;
+	U64 mClockPhase;
+	// Phase gain (shift) and edges since it was last lowered
+	U32 mPhaseShift;
+	U32 mPhaseEdges;
+
+	// Current interval: mIntervalBits bit periods between the edges at mIntervalStart and mIntervalEnd
+	// (8 for any longer interval)
+	U64 mIntervalStart;
+	U64 mIntervalEnd;
+	U32 mIntervalBits;
+	// Length and bits of the last interval computed (without clock recovery)
+	U64 mLastIntervalLength;
+	U32 mLastIntervalBits;
+	// Next bit of the interval to decode
+	U32 mNextBit;
+	// The 0 of the current interval is the last bit of a flag / a stuffed bit
+	bool mFlagZero;
+	bool mStuffedZero;
+
+	bool mHasUnread;
+	HdlcBitSyncItem mUnread;
+};
+
+#endif //HDLC_BIT_SYNC_DECODER
@@ -0,0 +1,89 @@
+#include "HdlcCommitScheduler.h"
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Bytes between two reads of the clock in ByteDone
+#define HDLC_COMMIT_CLOCK_BYTES 256
+
+HdlcCommitScheduler::HdlcCommitScheduler()
+{
+	Reset( 1, 0 );
+}
+
+void HdlcCommitScheduler::Reset( U32 maxFrames, U32 maxMilliseconds )
+{
+	mMaxFrames = maxFrames;
+	mMaxMilliseconds = maxMilliseconds;
+	mFrames = 0;
+	mBytes = 0;
+	mPendingResults = false;
+	mStart = Milliseconds();
+	mLastCommit = mStart;
+	mCommits = 0;
+}
+
+bool HdlcCommitScheduler::FrameDone()
+{
+	mFrames++;
+	// Nothing to commit (e.g. the frames left out by the frame filter)
+	if( !mPendingResults )
+	{
+		return false;
+	}
+	return mFrames >= mMaxFrames || Milliseconds() - mLastCommit >= mMaxMilliseconds;
+}
+
+bool HdlcCommitScheduler::ByteDone()
+{
+	if( !mPendingResults || ++mBytes < HDLC_COMMIT_CLOCK_BYTES )
+	{
+		return false;
+	}
+	mBytes = 0;
+	return Milliseconds() - mLastCommit >= mMaxMilliseconds;
+}
+
+void HdlcCommitScheduler::ResultAdded()
+{
+	mPendingResults = true;
+}
+
+bool HdlcCommitScheduler::HasPendingResults() const
+{
+	return mPendingResults;
+}
+
+void HdlcCommitScheduler::Committed()
+{
+	mFrames = 0;
+	mBytes = 0;
+	mPendingResults = false;
+	mLastCommit = Milliseconds();
+	mCommits++;
+}
+
+U64 HdlcCommitScheduler::GetCommits() const
+{
+	return mCommits;
+}
+
+double HdlcCommitScheduler::GetCommitsPerSecond() const
+{
+	U64 elapsed = mLastCommit - mStart;
+	return ( elapsed == 0 ) ? 0.0 : double( mCommits ) * 1000.0 / double( elapsed );
+}
+
+U64 HdlcCommitScheduler::Milliseconds()
+{
+#if defined( _WIN32 )
+	return U64( GetTickCount64() );
+#else
+	timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return U64( now.tv_sec ) * 1000 + U64( now.tv_nsec ) / 1000000;
+#endif
+}
@@ -0,0 +1,51 @@
+#ifndef HDLC_COMMIT_SCHEDULER
+#define HDLC_COMMIT_SCHEDULER
+
+#include <LogicPublicTypes.h>
+
+// Decides when the analyzer commits its results (CommitResults, ReportProgress and
+// CheckIfThreadShouldExit), which synchronizes with the application. Committing after every HDLC
+// frame costs more than decoding short frames, so the frames are committed in batches: when
+// maxMilliseconds have passed since the last commit or maxFrames have been decoded, whichever
+// comes first. The analyzer also commits the pending frames before it waits for more samples,
+// so the results of a live capture (or the last ones of a capture) show up at once.
+class HdlcCommitScheduler
+{
+public:
+	HdlcCommitScheduler();
+
+	void Reset( U32 maxFrames, U32 maxMilliseconds );
+	// Called after every HDLC frame. Returns true if the results have to be committed now (never
+	// when no field was added since the last commit).
+	bool FrameDone();
+	// Called for every byte or flag read, also inside a frame or a hunt for flags that doesn't end
+	// (e.g. a corrupted stream). Returns true if the time limit is reached: the clock is only read
+	// every 256 calls.
+	bool ByteDone();
+	// Called for every field added to the results
+	void ResultAdded();
+	// Fields added since the last commit (also the flags while hunting for a frame)
+	bool HasPendingResults() const;
+	void Committed();
+
+	U64 GetCommits() const;
+	// From the first frame to the last commit
+	double GetCommitsPerSecond() const;
+
+	// Monotonic wall clock
+	static U64 Milliseconds();
+
+protected:
+	U32 mMaxFrames;
+	U32 mMaxMilliseconds;
+	// Frames since the last commit
+	U32 mFrames;
+	// Bytes since the clock was last read
+	U32 mBytes;
+	bool mPendingResults;
+	U64 mStart;
+	U64 mLastCommit;
+	U64 mCommits;
+};
+
+#endif //HDLC_COMMIT_SCHEDULER
@@ -0,0 +1,418 @@
+#include "HdlcCrc.h"
+#include "HdlcCrcModel.h"
+
+// Carry-less multiplication kernels are only built for x86-64 (PCLMULQDQ + SSSE3),
+// and only used if the CPU running the analyzer supports them.
+#if defined( _M_X64 ) || defined( __x86_64__ )
+#define HDLC_CRC_CLMUL
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#if defined( _MSC_VER )
+#include <intrin.h>
+#define HDLC_CRC_CLMUL_TARGET
+#else
+#include <cpuid.h>
+#define HDLC_CRC_CLMUL_TARGET __attribute__(( target( "pclmul,ssse3" ) ))
+#endif
+#endif
+
+#ifdef HDLC_CRC_CLMUL
+
+// Folding CRC kernel with carry-less multiplications, for non reflected CRCs 
+// ("Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel).
+// The stream is loaded in 128 bits registers with the first byte in the msb position, so a register
+// is a polynomial of degree < 128 in the same bit order as the CRC. Four accumulators are folded
+// 64 bytes ahead while there is data, then reduced to one, and the final 16 bytes and the tail
+// are handed to the table engine.
+template< U32 Width, U32 Poly >
+class HdlcCrcFoldEngine
+{
+public:
+
+	static void InitConstants()
+	{
+		mFold128[ 0 ] = XPowModP( 128 + 64 );
+		mFold128[ 1 ] = XPowModP( 128 );
+		mFold512[ 0 ] = XPowModP( 512 + 64 );
+		mFold512[ 1 ] = XPowModP( 512 );
+	}
+
+	// Requires length >= 64
+	static HDLC_CRC_CLMUL_TARGET U32 Update( U32 crc, const U8* data, U64 length )
+	{
+		const __m128i byteSwap = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+		const __m128i fold512 = _mm_set_epi64x( mFold512[ 1 ], mFold512[ 0 ] );
+		const __m128i fold128 = _mm_set_epi64x( mFold128[ 1 ], mFold128[ 0 ] );
+
+		__m128i a0 = Load( data, byteSwap );
+		__m128i a1 = Load( data + 16, byteSwap );
+		__m128i a2 = Load( data + 32, byteSwap );
+		__m128i a3 = Load( data + 48, byteSwap );
+		data += 64;
+		length -= 64;
+
+		// The initial value of the CRC is xor-ed into the first bits of the stream
+		a0 = _mm_xor_si128( a0, _mm_set_epi32( int( crc << ( 32 - Width ) ), 0, 0, 0 ) );
+
+		while( length >= 64 )
+		{
+			a0 = Fold( a0, Load( data, byteSwap ), fold512 );
+			a1 = Fold( a1, Load( data + 16, byteSwap ), fold512 );
+			a2 = Fold( a2, Load( data + 32, byteSwap ), fold512 );
+			a3 = Fold( a3, Load( data + 48, byteSwap ), fold512 );
+			data += 64;
+			length -= 64;
+		}
+
+		a1 = Fold( a0, a1, fold128 );
+		a2 = Fold( a1, a2, fold128 );
+		a3 = Fold( a2, a3, fold128 );
+
+		while( length >= 16 )
+		{
+			a3 = Fold( a3, Load( data, byteSwap ), fold128 );
+			data += 16;
+			length -= 16;
+		}
+
+		U8 remainder[ 16 ];
+		_mm_storeu_si128( ( __m128i* ) remainder, _mm_shuffle_epi8( a3, byteSwap ) );
+		crc = HdlcCrcEngine< Width, Poly >::Update( 0, remainder, 16 );
+		return HdlcCrcEngine< Width, Poly >::Update( crc, data, length );
+	}
+
+protected:
+
+	static HDLC_CRC_CLMUL_TARGET __m128i Load( const U8* data, __m128i byteSwap )
+	{
+		return _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i* ) data ), byteSwap );
+	}
+
+	// acc * x^N + next, with the x^(N+64) mod P constant in the low qword of k and x^N mod P in the high one
+	static HDLC_CRC_CLMUL_TARGET __m128i Fold( __m128i acc, __m128i next, __m128i k )
+	{
+		__m128i hi = _mm_clmulepi64_si128( acc, k, 0x01 );
+		__m128i lo = _mm_clmulepi64_si128( acc, k, 0x10 );
+		return _mm_xor_si128( _mm_xor_si128( hi, lo ), next );
+	}
+
+	static U64 XPowModP( U32 n )
+	{
+		U64 r = 1;
+		for( U32 i=0; i < n; ++i )
+		{
+			r <<= 1;
+			if( r & ( U64( 1 ) << Width ) )
+			{
+				r ^= ( U64( 1 ) << Width ) | Poly;
+			}
+		}
+		return r;
+	}
+
+	static long long mFold128[ 2 ];
+	static long long mFold512[ 2 ];
+};
+
+template< U32 Width, U32 Poly >
+long long HdlcCrcFoldEngine< Width, Poly >::mFold128[ 2 ];
+template< U32 Width, U32 Poly >
+long long HdlcCrcFoldEngine< Width, Poly >::mFold512[ 2 ];
+
+typedef HdlcCrcFoldEngine< 16, 0x1021 > HdlcCrc16FoldEngine;
+typedef HdlcCrcFoldEngine< 32, 0x04C11DB7 > HdlcCrc32FoldEngine;
+
+static bool CpuSupportsClmul()
+{
+	U32 ecx;
+#if defined( _MSC_VER )
+	int info[ 4 ];
+	__cpuid( info, 1 );
+	ecx = U32( info[ 2 ] );
+#else
+	unsigned int eax, ebx, edx;
+	if( !__get_cpuid( 1, &eax, &ebx, &ecx, &edx ) )
+	{
+		return false;
+	}
+#endif
+	const U32 ssse3 = 1 << 9;
+	const U32 pclmulqdq = 1 << 1;
+	return ( ecx & ssse3 ) && ( ecx & pclmulqdq );
+}
+
+#endif //HDLC_CRC_CLMUL
+
+// Below this size the setup of the folding kernel costs more than the table lookups
+#define HDLC_CRC_CLMUL_MIN_BYTES 64
+
+static bool gUseClmul = false;
+
+static U32 gResidues[ HDLC_FCS32 + 1 ];
+
+
+// The tables are filled when the library is loaded, before any analyzer or simulation thread runs
+static class HdlcCrcTablesInitializer
+{
+public:
+	HdlcCrcTablesInitializer()
+	{
+		HdlcCrc8Engine::InitTables();
+		HdlcCrc16Engine::InitTables();
+		HdlcCrc32Engine::InitTables();
+		HdlcFcs16Model::Engine::InitTables();
+		HdlcFcs32Model::Engine::InitTables();
+		gResidues[ HDLC_CRC8 ] = HdlcCrc8Model::Residue();
+		gResidues[ HDLC_CRC16 ] = HdlcCrc16Model::Residue();
+		gResidues[ HDLC_CRC32 ] = HdlcCrc32Model::Residue();
+		gResidues[ HDLC_FCS16 ] = HdlcFcs16Model::Residue();
+		gResidues[ HDLC_FCS32 ] = HdlcFcs32Model::Residue();
+#ifdef HDLC_CRC_CLMUL
+		HdlcCrc16FoldEngine::InitConstants();
+		HdlcCrc32FoldEngine::InitConstants();
+		gUseClmul = CpuSupportsClmul();
+#endif
+	}
+} gHdlcCrcTablesInitializer;
+
+U32 HdlcCrc::Crc8( const U8* data, U64 length, U32 crc )
+{
+	return HdlcCrc8Engine::Update( crc, data, length );
+}
+
+U32 HdlcCrc::Crc16( const U8* data, U64 length, U32 crc )
+{
+#ifdef HDLC_CRC_CLMUL
+	if( gUseClmul && length >= HDLC_CRC_CLMUL_MIN_BYTES )
+	{
+		return HdlcCrc16FoldEngine::Update( crc, data, length );
+	}
+#endif
+	return HdlcCrc16Engine::Update( crc, data, length );
+}
+
+U32 HdlcCrc::Crc32( const U8* data, U64 length, U32 crc )
+{
+#ifdef HDLC_CRC_CLMUL
+	if( gUseClmul && length >= HDLC_CRC_CLMUL_MIN_BYTES )
+	{
+		return HdlcCrc32FoldEngine::Update( crc, data, length );
+	}
+#endif
+	return HdlcCrc32Engine::Update( crc, data, length );
+}
+
+U32 HdlcCrc::Init( HdlcFcsType fcsType )
+{
+	switch( fcsType )
+	{
+		case HDLC_CRC8: return HdlcCrc8Model::InitialRegister();
+		case HDLC_CRC16: return HdlcCrc16Model::InitialRegister();
+		case HDLC_CRC32: return HdlcCrc32Model::InitialRegister();
+		case HDLC_FCS16: return HdlcFcs16Model::InitialRegister();
+		case HDLC_FCS32: return HdlcFcs32Model::InitialRegister();
+	}
+	return 0;
+}
+
+U32 HdlcCrc::Final( HdlcFcsType fcsType, U32 crc )
+{
+	switch( fcsType )
+	{
+		case HDLC_CRC8: return HdlcCrc8Model::Final( crc );
+		case HDLC_CRC16: return HdlcCrc16Model::Final( crc );
+		case HDLC_CRC32: return HdlcCrc32Model::Final( crc );
+		case HDLC_FCS16: return HdlcFcs16Model::Final( crc );
+		case HDLC_FCS32: return HdlcFcs32Model::Final( crc );
+	}
+	return 0;
+}
+
+U32 HdlcCrc::Residue( HdlcFcsType fcsType )
+{
+	return gResidues[ fcsType ];
+}
+
+U32 HdlcCrc::Compute( HdlcFcsType fcsType, const U8* data, U64 length )
+{
+	return Final( fcsType, Update( fcsType, Init( fcsType ), data, length ) );
+}
+
+U32 HdlcCrc::Update( HdlcFcsType fcsType, U32 crc, const U8* data, U64 length )
+{
+	switch( fcsType )
+	{
+		case HDLC_CRC8: return Crc8( data, length, crc );
+		case HDLC_CRC16: return Crc16( data, length, crc );
+		case HDLC_CRC32: return Crc32( data, length, crc );
+		case HDLC_FCS16: return HdlcFcs16Model::Update( crc, data, length );
+		case HDLC_FCS32: return HdlcFcs32Model::Update( crc, data, length );
+	}
+	return 0;
+}
+
+U32 HdlcCrc::UpdateByte( HdlcFcsType fcsType, U32 crc, U8 byte )
+{
+	switch( fcsType )
+	{
+		case HDLC_CRC8: return HdlcCrc8Model::UpdateByte( crc, byte );
+		case HDLC_CRC16: return HdlcCrc16Model::UpdateByte( crc, byte );
+		case HDLC_CRC32: return HdlcCrc32Model::UpdateByte( crc, byte );
+		case HDLC_FCS16: return HdlcFcs16Model::UpdateByte( crc, byte );
+		case HDLC_FCS32: return HdlcFcs32Model::UpdateByte( crc, byte );
+	}
+	return 0;
+}
+
+U32 HdlcCrc::FcsBytes( HdlcFcsType fcsType )
+{
+	switch( fcsType )
+	{
+		case HDLC_CRC8: return 1;
+		case HDLC_CRC16: return 2;
+		case HDLC_CRC32: return 4;
+		case HDLC_FCS16: return 2;
+		case HDLC_FCS32: return 4;
+	}
+	return 0;
+}
+
+void HdlcCrc::BitErrorSyndromes( HdlcFcsType fcsType, U32* syndromes, U32 count )
+{
+	// Whole bytes only, the positions of the bits of a reflected CRC are reversed in every byte
+	vector<U32> all( ( count + 7 ) & ~7 );
+	switch( fcsType )
+	{
+		case HDLC_CRC8: HdlcCrc8Model::BitErrorSyndromes( &all[ 0 ], all.size() ); break;
+		case HDLC_CRC16: HdlcCrc16Model::BitErrorSyndromes( &all[ 0 ], all.size() ); break;
+		case HDLC_CRC32: HdlcCrc32Model::BitErrorSyndromes( &all[ 0 ], all.size() ); break;
+		case HDLC_FCS16: HdlcFcs16Model::BitErrorSyndromes( &all[ 0 ], all.size() ); break;
+		case HDLC_FCS32: HdlcFcs32Model::BitErrorSyndromes( &all[ 0 ], all.size() ); break;
+	}
+	for( U32 i=0; i < count; ++i )
+	{
+		syndromes[ i ] = all[ i ];
+	}
+}
+
+bool HdlcCrc::LsbByteFirst( HdlcFcsType fcsType )
+{
+	switch( fcsType )
+	{
+		case HDLC_CRC8: return HdlcCrc8Model::LsbByteFirst();
+		case HDLC_CRC16: return HdlcCrc16Model::LsbByteFirst();
+		case HDLC_CRC32: return HdlcCrc32Model::LsbByteFirst();
+		case HDLC_FCS16: return HdlcFcs16Model::LsbByteFirst();
+		case HDLC_FCS32: return HdlcFcs32Model::LsbByteFirst();
+	}
+	return false;
+}
+
+void HdlcCrc::CrcToBytes( HdlcFcsType fcsType, U32 crc, U8* bytes )
+{
+	U32 numberOfBytes = FcsBytes( fcsType );
+	bool lsbFirst = LsbByteFirst( fcsType );
+	for( U32 i=0; i < numberOfBytes; ++i )
+	{
+		U32 shift = lsbFirst ? 8 * i : 8 * ( numberOfBytes - 1 - i );
+		bytes[ i ] = U8( crc >> shift );
+	}
+}
+
+U32 HdlcCrc::BytesToCrc( HdlcFcsType fcsType, const U8* bytes )
+{
+	U32 numberOfBytes = FcsBytes( fcsType );
+	bool lsbFirst = LsbByteFirst( fcsType );
+	U32 crc = 0;
+	for( U32 i=0; i < numberOfBytes; ++i )
+	{
+		U32 shift = lsbFirst ? 8 * i : 8 * ( numberOfBytes - 1 - i );
+		crc |= U32( bytes[ i ] ) << shift;
+	}
+	return crc;
+}
+
+HdlcCrcSyndromeTable::HdlcCrcSyndromeTable()
+:	mBuilt( false ),
+	mFcsType( HDLC_CRC16 ),
+	mMaxBits( 0 ),
+	mMask( 0 ),
+	mShift( 32 )
+{
+}
+
+void HdlcCrcSyndromeTable::Build( HdlcFcsType fcsType )
+{
+	if( mBuilt && mFcsType == fcsType )
+	{
+		return;
+	}
+
+	U32 size = 1;
+	mShift = 32;
+	while( size < 2 * HDLC_CRC_SYNDROME_MAX_BITS )
+	{
+		size <<= 1;
+		mShift--;
+	}
+	mMask = size - 1;
+	mSyndromes.assign( size, 0 );
+	mPositions.assign( size, 0 );
+
+	vector<U32> syndromes( HDLC_CRC_SYNDROME_MAX_BITS );
+	HdlcCrc::BitErrorSyndromes( fcsType, &syndromes[ 0 ], HDLC_CRC_SYNDROME_MAX_BITS );
+
+	// The table covers whole bytes, up to the first byte with a repeated syndrome
+	mMaxBits = HDLC_CRC_SYNDROME_MAX_BITS;
+	for( U32 i=0; i < HDLC_CRC_SYNDROME_MAX_BITS; ++i )
+	{
+		U32 position;
+		if( Lookup( syndromes[ i ], position ) )
+		{
+			mMaxBits = i & ~7;
+			break;
+		}
+		U32 slot = Slot( syndromes[ i ] );
+		while( mSyndromes[ slot ] != 0 )
+		{
+			slot = ( slot + 1 ) & mMask;
+		}
+		mSyndromes[ slot ] = syndromes[ i ];
+		mPositions[ slot ] = i;
+	}
+
+	mFcsType = fcsType;
+	mBuilt = true;
+}
+
+// Fibonacci hashing: the msb bits of the product
+U32 HdlcCrcSyndromeTable::Slot( U32 syndrome ) const
+{
+	return U32( syndrome * 0x9E3779B1 ) >> mShift;
+}
+
+U32 HdlcCrcSyndromeTable::GetMaxBits() const
+{
+	return mMaxBits;
+}
+
+bool HdlcCrcSyndromeTable::Lookup( U32 syndrome, U32 & bitFromEnd ) const
+{
+	if( syndrome == 0 || mSyndromes.empty() )
+	{
+		return false;
+	}
+
+	U32 slot = Slot( syndrome );
+	while( mSyndromes[ slot ] != 0 )
+	{
+		if( mSyndromes[ slot ] == syndrome )
+		{
+			bitFromEnd = mPositions[ slot ];
+			return bitFromEnd < mMaxBits;
+		}
+		slot = ( slot + 1 ) & mMask;
+	}
+	return false;
+}
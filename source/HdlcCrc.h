@@ -0,0 +1,80 @@
+#ifndef HDLC_CRC
+#define HDLC_CRC
+
+#include "HdlcAnalyzerSettings.h"
+#include <vector>
+
+using namespace std;
+
+// Table driven CRC engine for the HDLC Frame Check Sequences.
+// ISO/IEC 13239:2002(E) page 13-14: non reflected and zero initialized CRCs, i.e. the remainder
+// of the division of the stream (followed by N 0-bits) by the generator polynomial.
+// RFC 1662: FCS-16 and FCS-32 of PPP (and LAPB), reflected, initialized with ones and complemented.
+// The CRCs are returned right aligned (the CRC16 of a frame is in the 16 lsb bits).
+
+// Implementation of the CRC16 and CRC32 for long streams: carry-less multiplication folding
+// when the CPU supports it (x86-64 with PCLMULQDQ), else lookup tables (slicing-by-8).
+// CRC8 always uses the lookup tables.
+
+class HdlcCrc
+{
+public:
+	// Zero initialized CRCs of ISO/IEC 13239 (crc is the CRC of the previous bytes)
+	static U32 Crc8( const U8* data, U64 length, U32 crc = 0 );
+	static U32 Crc16( const U8* data, U64 length, U32 crc = 0 );
+	static U32 Crc32( const U8* data, U64 length, U32 crc = 0 );
+
+	// Any FCS type: crc = Init(), crc = Update( crc, ... ) for every chunk of the frame and
+	// Final( crc ) is the CRC of the frame.
+	static U32 Init( HdlcFcsType fcsType );
+	static U32 Update( HdlcFcsType fcsType, U32 crc, const U8* data, U64 length );
+	static U32 UpdateByte( HdlcFcsType fcsType, U32 crc, U8 byte );
+	static U32 Final( HdlcFcsType fcsType, U32 crc );
+	static U32 Compute( HdlcFcsType fcsType, const U8* data, U64 length );
+	// Value of crc after Update() over a frame and its FCS bytes when the FCS is correct
+	static U32 Residue( HdlcFcsType fcsType );
+
+	static U32 FcsBytes( HdlcFcsType fcsType );
+	// Syndrome (register after a frame and its FCS, xor the residue) of every single bit error:
+	// syndromes[ 8 * j + b ] is the syndrome when the bit b (mask 1 << b) of the j-th byte counting
+	// from the end of the FCS (j = 0 is the last byte) is flipped, for 8 * j + b < count.
+	static void BitErrorSyndromes( HdlcFcsType fcsType, U32* syndromes, U32 count );
+
+	// Byte order of the FCS field: msb byte first, except for the reflected CRCs
+	static bool LsbByteFirst( HdlcFcsType fcsType );
+	// Bytes of the CRC in transmission order and back
+	static void CrcToBytes( HdlcFcsType fcsType, U32 crc, U8* bytes );
+	static U32 BytesToCrc( HdlcFcsType fcsType, const U8* bytes );
+};
+
+// Frames up to this size (FCS included) get their single bit errors located
+#define HDLC_CRC_SYNDROME_MAX_BITS ( 4096 * 8 )
+
+// Syndrome -> position of the flipped bit, for the single bit errors of a FCS type.
+// Open addressing hash table, O(1) lookups.
+class HdlcCrcSyndromeTable
+{
+public:
+	HdlcCrcSyndromeTable();
+
+	void Build( HdlcFcsType fcsType );
+	// Frames longer than this (in bits, FCS included) can't be located: the syndromes of a CRC
+	// repeat with the period of its polynomial (127 bits for the CRC8)
+	U32 GetMaxBits() const;
+	// bitFromEnd = 8 * j + b as in HdlcCrc::BitErrorSyndromes. False if it's not a single bit error
+	bool Lookup( U32 syndrome, U32 & bitFromEnd ) const;
+
+protected:
+	U32 Slot( U32 syndrome ) const;
+
+	bool mBuilt;
+	HdlcFcsType mFcsType;
+	U32 mMaxBits;
+	U32 mMask;
+	U32 mShift;
+	// A syndrome is never 0, so 0 is an empty slot
+	vector<U32> mSyndromes;
+	vector<U32> mPositions;
+};
+
+#endif //HDLC_CRC
@@ -0,0 +1,278 @@
+#ifndef HDLC_CRC_MODEL
+#define HDLC_CRC_MODEL
+
+#include "HdlcCrc.h"
+
+// CRC models of the FCS types, with all their parameters resolved at compile time. HdlcCrc
+// dispatches on the FCS type at run time; code specialized on the FCS type (the frame decoder)
+// uses the models directly through HdlcCrcModelOf, so the byte-wise update is inlined.
+// The tables are filled by HdlcCrc.cpp when the library is loaded.
+
+// Byte-wise and slicing-by-8 tables for a non reflected CRC.
+// The registers and the tables are left aligned to 32 bits (the polynomial of a CRC8 is
+// 0x07000000), so the same code serves the 8, 16 and 32 bits CRCs.
+template< U32 Width, U32 Poly >
+class HdlcCrcEngine
+{
+public:
+
+	static void InitTables()
+	{
+		const U32 poly = Poly << ( 32 - Width );
+		for( U32 b=0; b < 256; ++b )
+		{
+			U32 crc = b << 24;
+			for( U32 i=0; i < 8; ++i )
+			{
+				crc = ( crc & 0x80000000 ) ? ( crc << 1 ) ^ poly : ( crc << 1 );
+			}
+			mTables[ 0 ][ b ] = crc;
+		}
+
+		// mTables[ k ][ b ] is the CRC of the byte b followed by k 0-bytes
+		for( U32 k=1; k < 8; ++k )
+		{
+			for( U32 b=0; b < 256; ++b )
+			{
+				U32 prev = mTables[ k - 1 ][ b ];
+				mTables[ k ][ b ] = ( prev << 8 ) ^ mTables[ 0 ][ prev >> 24 ];
+			}
+		}
+	}
+
+	static U32 UpdateByte( U32 crc, U8 byte )
+	{
+		crc <<= ( 32 - Width );
+		crc = ( crc << 8 ) ^ mTables[ 0 ][ ( crc >> 24 ) ^ byte ];
+		return crc >> ( 32 - Width );
+	}
+
+	static U32 Update( U32 crc, const U8* data, U64 length )
+	{
+		crc <<= ( 32 - Width );
+
+		// Slicing-by-8: 8 bytes per iteration
+		while( length >= 8 )
+		{
+			U32 x = crc ^ ( ( U32( data[ 0 ] ) << 24 ) | ( U32( data[ 1 ] ) << 16 ) |
+							( U32( data[ 2 ] ) << 8 ) | U32( data[ 3 ] ) );
+			crc = mTables[ 7 ][ x >> 24 ] ^ mTables[ 6 ][ ( x >> 16 ) & 0xFF ] ^
+				  mTables[ 5 ][ ( x >> 8 ) & 0xFF ] ^ mTables[ 4 ][ x & 0xFF ] ^
+				  mTables[ 3 ][ data[ 4 ] ] ^ mTables[ 2 ][ data[ 5 ] ] ^
+				  mTables[ 1 ][ data[ 6 ] ] ^ mTables[ 0 ][ data[ 7 ] ];
+			data += 8;
+			length -= 8;
+		}
+
+		// Byte-wise for the remaining bytes
+		while( length-- > 0 )
+		{
+			crc = ( crc << 8 ) ^ mTables[ 0 ][ ( crc >> 24 ) ^ *data++ ];
+		}
+
+		return crc >> ( 32 - Width );
+	}
+
+protected:
+	static U32 mTables[ 8 ][ 256 ];
+};
+
+template< U32 Width, U32 Poly >
+U32 HdlcCrcEngine< Width, Poly >::mTables[ 8 ][ 256 ];
+
+inline U32 ReflectBits( U32 value, U32 width )
+{
+	U32 ret = 0;
+	for( U32 i=0; i < width; ++i )
+	{
+		if( value & ( U32( 1 ) << i ) )
+		{
+			ret |= U32( 1 ) << ( width - 1 - i );
+		}
+	}
+	return ret;
+}
+
+// Same as HdlcCrcEngine for a reflected CRC (the lsb of every byte is the first bit on the wire).
+// The registers are right aligned and hold the CRC bits in reverse order.
+template< U32 Width, U32 Poly >
+class HdlcCrcReflectedEngine
+{
+public:
+
+	static void InitTables()
+	{
+		const U32 poly = ReflectBits( Poly, Width );
+		for( U32 b=0; b < 256; ++b )
+		{
+			U32 crc = b;
+			for( U32 i=0; i < 8; ++i )
+			{
+				crc = ( crc & 1 ) ? ( crc >> 1 ) ^ poly : ( crc >> 1 );
+			}
+			mTables[ 0 ][ b ] = crc;
+		}
+
+		for( U32 k=1; k < 8; ++k )
+		{
+			for( U32 b=0; b < 256; ++b )
+			{
+				U32 prev = mTables[ k - 1 ][ b ];
+				mTables[ k ][ b ] = ( prev >> 8 ) ^ mTables[ 0 ][ prev & 0xFF ];
+			}
+		}
+	}
+
+	static U32 UpdateByte( U32 crc, U8 byte )
+	{
+		return ( crc >> 8 ) ^ mTables[ 0 ][ ( crc ^ byte ) & 0xFF ];
+	}
+
+	static U32 Update( U32 crc, const U8* data, U64 length )
+	{
+		while( length >= 8 )
+		{
+			U32 x = crc ^ ( U32( data[ 0 ] ) | ( U32( data[ 1 ] ) << 8 ) |
+							( U32( data[ 2 ] ) << 16 ) | ( U32( data[ 3 ] ) << 24 ) );
+			crc = mTables[ 7 ][ x & 0xFF ] ^ mTables[ 6 ][ ( x >> 8 ) & 0xFF ] ^
+				  mTables[ 5 ][ ( x >> 16 ) & 0xFF ] ^ mTables[ 4 ][ x >> 24 ] ^
+				  mTables[ 3 ][ data[ 4 ] ] ^ mTables[ 2 ][ data[ 5 ] ] ^
+				  mTables[ 1 ][ data[ 6 ] ] ^ mTables[ 0 ][ data[ 7 ] ];
+			data += 8;
+			length -= 8;
+		}
+
+		if( length > 0 )
+		{
+			U32 x = crc;
+			U32 next = ( length < 4 ) ? crc >> ( 8 * length ) : 0;
+			for( U32 i=0; i < length; ++i )
+			{
+				U32 byte = ( i < 4 ) ? ( ( x >> ( 8 * i ) ) & 0xFF ) ^ data[ i ] : data[ i ];
+				next ^= mTables[ length - 1 - i ][ byte ];
+			}
+			crc = next;
+		}
+
+		return crc;
+	}
+
+protected:
+	static U32 mTables[ 8 ][ 256 ];
+};
+
+template< U32 Width, U32 Poly >
+U32 HdlcCrcReflectedEngine< Width, Poly >::mTables[ 8 ][ 256 ];
+
+template< U32 Width, U32 Poly, bool Reflected >
+struct HdlcCrcKernel
+{
+	typedef HdlcCrcEngine< Width, Poly > Engine;
+};
+
+template< U32 Width, U32 Poly >
+struct HdlcCrcKernel< Width, Poly, true >
+{
+	typedef HdlcCrcReflectedEngine< Width, Poly > Engine;
+};
+
+// CRC described with the parameters of the Rocksoft model ("A Painless Guide to CRC Error
+// Detection Algorithms", R. Williams): width, poly, init, refin, refout and xorout.
+// Every model gets its own kernel, the parameters are resolved at compile time.
+// The value of the register passed between calls is not the CRC: Final() returns the CRC.
+template< U32 Width, U32 Poly, U32 Init, bool RefIn, bool RefOut, U32 XorOut >
+class HdlcCrcModel
+{
+public:
+	typedef typename HdlcCrcKernel< Width, Poly, RefIn >::Engine Engine;
+	// Bytes of the FCS field
+	enum { FcsBytes = Width / 8 };
+
+	static U32 InitialRegister()
+	{
+		return RefIn ? ReflectBits( Init, Width ) : Init;
+	}
+
+	static U32 Update( U32 crc, const U8* data, U64 length )
+	{
+		return Engine::Update( crc, data, length );
+	}
+
+	static U32 UpdateByte( U32 crc, U8 byte )
+	{
+		return Engine::UpdateByte( crc, byte );
+	}
+
+	static U32 Final( U32 crc )
+	{
+		return ( ( RefIn != RefOut ) ? ReflectBits( crc, Width ) : crc ) ^ XorOut;
+	}
+
+	// A reflected CRC is transmitted lsb byte first, so its bits go out in the order of the register
+	static bool LsbByteFirst()
+	{
+		return RefOut;
+	}
+
+	// Register after a frame followed by its correct CRC, whatever the frame ("good FCS").
+	// It is the register after the CRC of an empty frame.
+	static U32 Residue()
+	{
+		U8 bytes[ 4 ];
+		U32 crc = Final( InitialRegister() );
+		for( U32 i=0; i < Width / 8; ++i )
+		{
+			U32 shift = LsbByteFirst() ? 8 * i : Width - 8 * ( i + 1 );
+			bytes[ i ] = U8( crc >> shift );
+		}
+		return Update( InitialRegister(), bytes, Width / 8 );
+	}
+
+	// The change of the register caused by a flipped bit followed by d bits is the register after
+	// a 1-bit followed by d 0-bits, starting from 0 (the CRC is linear)
+	static void BitErrorSyndromes( U32* syndromes, U32 count )
+	{
+		const U32 mask = ( ( U32( 1 ) << ( Width - 1 ) ) << 1 ) - 1;
+		const U32 poly = RefIn ? ReflectBits( Poly, Width ) : Poly;
+		U32 crc = poly;
+		for( U32 d=0; d < count; ++d )
+		{
+			// The bits of a byte are processed msb first, or lsb first if reflected
+			U32 bit = RefIn ? 7 - ( d % 8 ) : d % 8;
+			syndromes[ ( d & ~7 ) | bit ] = crc;
+			if( RefIn )
+			{
+				crc = ( crc & 1 ) ? ( crc >> 1 ) ^ poly : ( crc >> 1 );
+			}
+			else
+			{
+				crc = ( crc & ( U32( 1 ) << ( Width - 1 ) ) ) ? ( ( crc << 1 ) ^ poly ) & mask : ( crc << 1 ) & mask;
+			}
+		}
+	}
+};
+
+// ISO/IEC 13239:2002(E) page 14
+// CRC8 - x**8 + x**2 + x + 1
+typedef HdlcCrcEngine< 8, 0x07 > HdlcCrc8Engine;
+typedef HdlcCrcModel< 8, 0x07, 0, false, false, 0 > HdlcCrc8Model;
+// CRC16 - x**16 + x**12 + x**5 + 1
+typedef HdlcCrcEngine< 16, 0x1021 > HdlcCrc16Engine;
+typedef HdlcCrcModel< 16, 0x1021, 0, false, false, 0 > HdlcCrc16Model;
+// ISO/IEC 13239:2002(E) page 13
+// CRC32 - x**32 + x**26 + x**23 + x**22 + x**16 + x**12 + x**11 + x**10 + x**8 + x**7 + x**5 + x**4 + x**2 + x + 1
+typedef HdlcCrcEngine< 32, 0x04C11DB7 > HdlcCrc32Engine;
+typedef HdlcCrcModel< 32, 0x04C11DB7, 0, false, false, 0 > HdlcCrc32Model;
+// RFC 1662 (PPP in HDLC-like Framing) appendix C: same polynomials, reflected, initialized
+// with ones and complemented
+typedef HdlcCrcModel< 16, 0x1021, 0xFFFF, true, true, 0xFFFF > HdlcFcs16Model;
+typedef HdlcCrcModel< 32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF > HdlcFcs32Model;
+
+template< HdlcFcsType FcsType > struct HdlcCrcModelOf;
+template<> struct HdlcCrcModelOf< HDLC_CRC8 > { typedef HdlcCrc8Model Model; };
+template<> struct HdlcCrcModelOf< HDLC_CRC16 > { typedef HdlcCrc16Model Model; };
+template<> struct HdlcCrcModelOf< HDLC_CRC32 > { typedef HdlcCrc32Model Model; };
+template<> struct HdlcCrcModelOf< HDLC_FCS16 > { typedef HdlcFcs16Model Model; };
+template<> struct HdlcCrcModelOf< HDLC_FCS32 > { typedef HdlcFcs32Model Model; };
+
+#endif //HDLC_CRC_MODEL
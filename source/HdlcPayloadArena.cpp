@@ -0,0 +1,97 @@
+#include "HdlcPayloadArena.h"
+
+HdlcPayloadArena::HdlcPayloadArena()
+:	mSize( 0 )
+{
+	for( U32 i=0; i < HDLC_PAYLOAD_ARENA_MAX_BLOCKS; ++i )
+	{
+		mBlocks[ i ] = 0;
+		mEscapedBits[ i ] = 0;
+	}
+}
+
+HdlcPayloadArena::~HdlcPayloadArena()
+{
+	Clear();
+}
+
+void HdlcPayloadArena::Clear()
+{
+	for( U32 i=0; i < HDLC_PAYLOAD_ARENA_MAX_BLOCKS; ++i )
+	{
+		delete[] mBlocks[ i ];
+		delete[] mEscapedBits[ i ];
+		mBlocks[ i ] = 0;
+		mEscapedBits[ i ] = 0;
+	}
+	mSize = 0;
+}
+
+// Block k has 2^k times the bytes of the first one and starts after the bytes of the previous
+// ones: offset + first block size = first block size * 2^k + index
+U32 HdlcPayloadArena::Block( U64 offset, U64 & index )
+{
+	U64 position = ( offset >> HDLC_PAYLOAD_ARENA_FIRST_BLOCK_SHIFT ) + 1;
+	U32 block = 0;
+	while( position >>= 1 )
+	{
+		block++;
+	}
+	index = offset + ( U64( 1 ) << HDLC_PAYLOAD_ARENA_FIRST_BLOCK_SHIFT ) - BlockSize( block );
+	return block;
+}
+
+U64 HdlcPayloadArena::BlockSize( U32 block )
+{
+	return U64( 1 ) << ( HDLC_PAYLOAD_ARENA_FIRST_BLOCK_SHIFT + block );
+}
+
+U64 HdlcPayloadArena::Append( U8 value, bool escaped )
+{
+	U64 index;
+	U32 block = Block( mSize, index );
+	if( mBlocks[ block ] == 0 )
+	{
+		mBlocks[ block ] = new U8[ BlockSize( block ) ];
+		mEscapedBits[ block ] = new U8[ BlockSize( block ) / 8 ]();
+	}
+
+	mBlocks[ block ][ index ] = value;
+	// The bit might be set by a truncated byte
+	if( escaped )
+	{
+		mEscapedBits[ block ][ index / 8 ] |= U8( 1 << ( index % 8 ) );
+	}
+	else
+	{
+		mEscapedBits[ block ][ index / 8 ] &= U8( ~( 1 << ( index % 8 ) ) );
+	}
+	return mSize++;
+}
+
+void HdlcPayloadArena::Truncate( U64 size )
+{
+	if( size < mSize )
+	{
+		mSize = size;
+	}
+}
+
+U64 HdlcPayloadArena::GetSize() const
+{
+	return mSize;
+}
+
+U8 HdlcPayloadArena::GetByte( U64 offset ) const
+{
+	U64 index;
+	U32 block = Block( offset, index );
+	return mBlocks[ block ][ index ];
+}
+
+bool HdlcPayloadArena::IsEscaped( U64 offset ) const
+{
+	U64 index;
+	U32 block = Block( offset, index );
+	return ( ( mEscapedBits[ block ][ index / 8 ] >> ( index % 8 ) ) & 1 ) != 0;
+}
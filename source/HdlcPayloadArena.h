@@ -0,0 +1,44 @@
+#ifndef HDLC_PAYLOAD_ARENA
+#define HDLC_PAYLOAD_ARENA
+
+#include <LogicPublicTypes.h>
+
+// Append-only store of the information bytes of the compact information fields (a Frame per
+// byte costs about 40 bytes). Every byte has an offset (the bytes of a field are contiguous) and
+// an escaped bit (the byte came after a 0x7D) kept in a bitmap beside the bytes.
+// The bytes are kept in blocks that double in size and are never moved, so the bytes already
+// added can be read (by the user interface) while new ones are appended (by the worker thread).
+class HdlcPayloadArena
+{
+public:
+	HdlcPayloadArena();
+	~HdlcPayloadArena();
+
+	void Clear();
+	// Returns the offset of the byte
+	U64 Append( U8 value, bool escaped );
+	U64 GetSize() const;
+	// Drops the bytes from size on (the bytes of a frame that is not shown), the blocks are kept
+	void Truncate( U64 size );
+
+	U8 GetByte( U64 offset ) const;
+	bool IsEscaped( U64 offset ) const;
+
+protected:
+	enum { HDLC_PAYLOAD_ARENA_FIRST_BLOCK_SHIFT = 16, HDLC_PAYLOAD_ARENA_MAX_BLOCKS = 40 };
+
+	// Block of a byte and the index of the byte in the block
+	static U32 Block( U64 offset, U64 & index );
+	static U64 BlockSize( U32 block );
+
+	U8* mBlocks[ HDLC_PAYLOAD_ARENA_MAX_BLOCKS ];
+	U8* mEscapedBits[ HDLC_PAYLOAD_ARENA_MAX_BLOCKS ];
+	U64 mSize;
+
+private:
+	// Not copyable (owns the blocks)
+	HdlcPayloadArena( const HdlcPayloadArena & );
+	HdlcPayloadArena & operator=( const HdlcPayloadArena & );
+};
+
+#endif //HDLC_PAYLOAD_ARENA
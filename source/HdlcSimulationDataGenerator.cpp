@@ -1,5 +1,6 @@
 #include "HdlcSimulationDataGenerator.h"
 #include "HdlcAnalyzerSettings.h"
+#include "HdlcCrc.h"
 #include <AnalyzerHelpers.h>
 #include <cstdlib>
 #include <iostream>
@@ -241,20 +242,7 @@ void HdlcSimulationDataGenerator::CreateHDLCFrame( const vector<U8> & address, c
 
 vector<U8> HdlcSimulationDataGenerator::GenFcs( HdlcFcsType fcsType, const vector<U8> & stream ) const
 {
-	vector<U8> crcRet;
-	switch( fcsType ) 
-	{
-		case HDLC_CRC8: 
-			crcRet = Crc8( stream );
-			break;
-		case HDLC_CRC16:
-			crcRet = Crc16( stream );
-			break;
-		case HDLC_CRC32:
-			crcRet = Crc32( stream );
-			break;
-	}
-	return crcRet;
+	return CrcToVector( fcsType, HdlcCrc::Compute( fcsType, stream.empty() ? 0 : &stream[ 0 ], stream.size() ) );
 }
 
 void HdlcSimulationDataGenerator::TransmitBitSync( const vector<U8> & stream ) 
@@ -450,146 +438,9 @@ void HdlcSimulationDataGenerator::CreateAsyncByte( U8 byte )
 ////////////////////// Static functions /////////////////////////////////////////////////////
 //
 
-vector<BitState> HdlcSimulationDataGenerator::BytesVectorToBitsVector( const vector<U8> & v, U32 numberOfBits )
-{
-	vector<BitState> bitsRet;
-	U32 vectorIndex = 0;
-	U8 byte;
-	bool getByte = true;
-	U8 bytePos = 0x80;
-	for( U32 i=0; i < numberOfBits; ++i )
-	{
-		if( getByte )
-		{
-			byte = v.at( vectorIndex );
-			bytePos = 0x80;
-			vectorIndex++;
-		}
-		
-		BitState bit = ( byte & bytePos ) ? BIT_HIGH : BIT_LOW;
-		bitsRet.push_back( bit );
-		
-		bytePos >>= 1;
-		
-		getByte = ( ( i+1 ) % 8 == 0 );
-		
-	}
-	
-	return bitsRet;
-}
-
-vector<U8> HdlcSimulationDataGenerator::CrcDivision( const vector<U8> & stream, const vector<U8> & genPoly, U32 crcNumber )
+vector<U8> HdlcSimulationDataGenerator::CrcToVector( HdlcFcsType fcsType, U32 crc )
 {
-	
-	vector<BitState> dataBits = BytesVectorToBitsVector( stream, stream.size() * 8 );
-	vector<BitState> polyBits = BytesVectorToBitsVector( genPoly, crcNumber + 1 );
-
-  U32 dataIndex=0;
-	U32 dataLimit = dataBits.size() - ( polyBits.size() - 1 );
-	while( dataIndex < dataLimit )
-	{
-		
-		// Advance one-position or 0-bits
-		bool zeroBits = true;
-		while( zeroBits )
-		{
-			zeroBits = ( ( dataBits.at( dataIndex ) == BIT_LOW ) && 
-					     ( dataIndex < dataLimit ) );
-			if( zeroBits ) 
-			{
-				dataIndex++;
-			}
-		}
-		
-		if( dataIndex < dataLimit )
-		{
-			for( U32 bitIndex = 0; bitIndex < polyBits.size(); ++bitIndex )
-			{
-				BitState bit = dataBits.at( dataIndex + bitIndex );
-				BitState polyBit = polyBits.at( bitIndex );
-				
-				dataBits[ dataIndex + bitIndex ] = BitState( bit ^ polyBit );
-			}
-		}
-		
-		dataIndex++;
-		
-	}
-	
-	// put the crc result in the vector of bytes
-	vector<U8> crcRet;
-	U8 offset = crcNumber;
-	for( U32 s=0; s < crcNumber / 8; ++s ) 
-	{
-		U64 byteValue= 0;
-		DataBuilder dbyte;
-		dbyte.Reset( &byteValue, AnalyzerEnums::MsbFirst, 8 );
-		for( U32 i=dataBits.size() - offset; i < dataBits.size() - offset + 8; ++i )
-		{
-			dbyte.AddBit( dataBits.at(i) );
-		}
-		offset -= 8;
-		crcRet.push_back( byteValue );
-	}
-	
-	return crcRet;
-	
-}
-
-vector<U8> HdlcSimulationDataGenerator::Crc8( const vector<U8> & stream )
-{
-	vector<U8> result = stream;
-	result.push_back( 0x00 );
-
-	// ISO/IEC 13239:2002(E) page 14
-	// CRC8 Divisor (9 bits) - x**8 + x**2 + x + 1
-	vector<U8> divisor;
-	divisor.push_back( 0x83 );
-	divisor.push_back( 0x80 );
-	
-	vector<U8> crc8Ret = CrcDivision( result, divisor, 8 );
-	return crc8Ret;
-}
-
-vector<U8> HdlcSimulationDataGenerator::Crc16( const vector<U8> & stream )
-{
-	vector<U8> result = stream;
-    
-  // Append 16 0-bits
-	result.push_back( 0x00 );
-	result.push_back( 0x00 );
-	
-  // ISO/IEC 13239:2002(E) page 14
-	// CRC16 Divisor (17 bits) - x**16 + x**12 + x**5 + 1 (0x1021)
-	vector<U8> divisor;
-	divisor.push_back( 0x88 );
-	divisor.push_back( 0x10 );
-	divisor.push_back( 0x80 );
-  
-  vector<U8> crc16Ret = CrcDivision( result, divisor, 16 );
-  
-  return crc16Ret;
-}
-
-vector<U8> HdlcSimulationDataGenerator::Crc32( const vector<U8> & stream )
-{
-	vector<U8> result = stream;
-  // Append 32 0-bits 
-  result.push_back( 0x00 );
-  result.push_back( 0x00 );
-  result.push_back( 0x00 );
-  result.push_back( 0x00 );
-
-	// ISO/IEC 13239:2002(E) page 13
-	// CRC32 Divisor (33 bits)
-	vector<U8> divisor;
-	divisor.push_back( 0x82 );
-	divisor.push_back( 0x60 );
-	divisor.push_back( 0x8E );
-	divisor.push_back( 0xDB );
-	divisor.push_back( 0x80 );
-	
-	vector<U8> crc32Ret = CrcDivision( result, divisor, 32 );
-	return crc32Ret;
-
+	U8 bytes[ 4 ];
+	HdlcCrc::CrcToBytes( fcsType, crc, bytes );
+	return vector<U8>( bytes, bytes + HdlcCrc::FcsBytes( fcsType ) );
 }
@@ -17,11 +17,7 @@ public:
 	void Initialize( U32 simulation_sample_rate, HdlcAnalyzerSettings* settings );
 	U32 GenerateSimulationData( U64 newest_sample_requested, U32 sample_rate, SimulationChannelDescriptor** simulation_channel );
 	
-	static vector<U8> Crc8( const vector<U8> & stream );
-	static vector<U8> Crc16( const vector<U8> & stream );
-	static vector<U8> Crc32( const vector<U8> & stream );
-	static vector<U8> CrcDivision( const vector<U8> & stream, const vector<U8> & genPoly, U32 crcNumber );
-	static vector<BitState> BytesVectorToBitsVector( const vector<U8> & v, U32 numberOfBits );
+	static vector<U8> CrcToVector( HdlcFcsType fcsType, U32 crc );
 
 protected:
 	
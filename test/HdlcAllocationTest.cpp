@@ -0,0 +1,139 @@
+// Counts the allocations of the analyzer while it decodes simulated captures of N and 4N samples:
+// decoding the frames must not allocate once the buffers of the analyzer are set up, so the
+// longer capture may only add the few allocations of the growing payload arena of the results.
+// The frames and markers of the stand-in SDK are given room before the decoding starts.
+//
+// Build and run from the repository root with the stand-in SDK:
+//   g++ -std=c++03 -Itest/sdk -Isource source/*.cpp test/sdk/AnalyzerSdk.cpp test/HdlcAllocationTest.cpp -o HdlcAllocationTest
+//   ./HdlcAllocationTest
+#include "HdlcAnalyzer.h"
+#include "HdlcAnalyzerSettings.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Allocations the payload arena may add when the capture is 4 times longer (it doubles)
+#define HDLC_TEST_ARENA_ALLOCATIONS 4
+
+static bool gCountAllocations = false;
+static U64 gAllocations = 0;
+
+void* operator new( size_t size ) throw( std::bad_alloc )
+{
+	if( gCountAllocations )
+	{
+		gAllocations++;
+	}
+	void* memory = malloc( size != 0 ? size : 1 );
+	if( memory == NULL )
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[]( size_t size ) throw( std::bad_alloc )
+{
+	return operator new( size );
+}
+
+void operator delete( void* memory ) throw()
+{
+	free( memory );
+}
+
+void operator delete[]( void* memory ) throw()
+{
+	free( memory );
+}
+
+enum TestSettings { TEST_DEFAULTS = 0, TEST_LOCATE_BIT_ERRORS, TEST_COMPACT_INFORMATION, TEST_FILTER_AND_REPEATS, 
+					TEST_TYPE_FILTER_HIDDEN, TEST_SETTINGS_COUNT };
+
+static void SetTestSettings( HdlcAnalyzerSettings* settings, TestSettings testSettings )
+{
+	switch( testSettings )
+	{
+		case TEST_LOCATE_BIT_ERRORS:
+			settings->mLocateBitErrors = true;
+			settings->mWithHcsField = true;
+			break;
+		case TEST_COMPACT_INFORMATION:
+			settings->mCompactInformationField = true;
+			break;
+		case TEST_FILTER_AND_REPEATS:
+			settings->mAddressFilter = HDLC_ADDRESS_FILTER_DENY;
+			settings->mFilterAddresses.push_back( 0x01 );
+			settings->mFilterAddresses.push_back( 0x03 );
+			settings->mCollapseRepeatedFrames = true;
+			break;
+		case TEST_TYPE_FILTER_HIDDEN:
+			settings->mFrameTypeFilter = HDLC_FRAME_TYPE_FILTER_I;
+			settings->mFilteredFrames = HDLC_FILTERED_HIDDEN;
+			settings->mCollapseFillFlags = true;
+			break;
+		default:
+			break;
+	}
+}
+
+// Allocations made by WorkerThread for a capture of the samples
+static U64 CountAllocations( HdlcTransmissionModeType mode, HdlcBitSyncDecoderType decoder, TestSettings testSettings, U64 samples )
+{
+	HdlcAnalyzer analyzer;
+	HdlcAnalyzerSettings* settings = static_cast< HdlcAnalyzerSettings* >( analyzer.mTestSettings );
+	settings->mInputChannel = Channel( 0, 0, DIGITAL );
+	settings->mBitRate = 2000000;
+	settings->mTransmissionMode = mode;
+	settings->mBitSyncDecoder = decoder;
+	SetTestSettings( settings, testSettings );
+	analyzer.mTestSampleRate = settings->mBitRate * 8;
+	analyzer.mTestReservedResults = samples / 16;
+
+	SimulationChannelDescriptor* simulation = 0;
+	analyzer.GenerateSimulationData( samples, analyzer.mTestSampleRate, &simulation );
+	AnalyzerChannelData data( simulation->GetInitialBitState(), simulation->mTransitions, simulation->GetCurrentSampleNumber() );
+	analyzer.mTestChannelData = &data;
+
+	gAllocations = 0;
+	gCountAllocations = true;
+	try
+	{
+		analyzer.WorkerThread();
+	}
+	catch( AnalyzerEndOfData& )
+	{
+	}
+	gCountAllocations = false;
+	return gAllocations;
+}
+
+int main( int argc, char* argv[] )
+{
+	const HdlcBitSyncDecoderType decoders[] = { HDLC_BIT_SYNC_DECODER_SAMPLING, HDLC_BIT_SYNC_DECODER_EDGES, HDLC_BIT_SYNC_DECODER_DPLL };
+	const U64 samples = 1000000;
+
+	U32 tests = 0;
+	U32 failures = 0;
+	for( U32 m = 0; m < 4; ++m )
+	{
+		HdlcTransmissionModeType mode = ( m < 3 ) ? HDLC_TRANSMISSION_BIT_SYNC : HDLC_TRANSMISSION_BYTE_ASYNC;
+		HdlcBitSyncDecoderType decoder = decoders[ ( m < 3 ) ? m : 0 ];
+		for( U32 t = 0; t < TEST_SETTINGS_COUNT; ++t )
+		{
+			U64 allocations = CountAllocations( mode, decoder, TestSettings( t ), samples );
+			U64 allocations4 = CountAllocations( mode, decoder, TestSettings( t ), samples * 4 );
+			tests++;
+			if( allocations4 > allocations + HDLC_TEST_ARENA_ALLOCATIONS )
+			{
+				failures++;
+				printf( "FAILED: " );
+			}
+			printf( "mode %d decoder %d settings %u: %llu allocations for %llu samples, %llu for %llu samples\n", 
+					mode, decoder, t, allocations, samples, allocations4, samples * 4 );
+		}
+	}
+
+	printf( "%u of %u decodings without allocations per frame\n", tests - failures, tests );
+	return ( failures == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// Decodes simulated captures that end in the middle of a corrupted stream (some edges dropped, so
+// frames, bytes and flags are broken anywhere) and checks that every field added to the results
+// is committed when the analyzer waits for the rest of the capture. The commits of a capture
+// that never ends a frame again depend on that.
+//
+// Build and run from the repository root with the stand-in SDK:
+//   g++ -std=c++03 -Itest/sdk -Isource source/*.cpp test/sdk/AnalyzerSdk.cpp test/HdlcCaptureEndTest.cpp -o HdlcCaptureEndTest
+//   ./HdlcCaptureEndTest
+#include "HdlcAnalyzer.h"
+#include "HdlcAnalyzerSettings.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+// Every dropEdges-th transition is left out (0: none)
+static bool DecodeCapture( HdlcTransmissionModeType mode, HdlcBitSyncDecoderType decoder, HdlcFcsType fcs, 
+						   U32 dropEdges, U64 samples, U32 seed )
+{
+	HdlcAnalyzer analyzer;
+	HdlcAnalyzerSettings* settings = static_cast< HdlcAnalyzerSettings* >( analyzer.mTestSettings );
+	settings->mInputChannel = Channel( 0, 0, DIGITAL );
+	settings->mBitRate = 2000000;
+	settings->mTransmissionMode = mode;
+	settings->mBitSyncDecoder = decoder;
+	settings->mHdlcFcs = fcs;
+	analyzer.mTestSampleRate = settings->mBitRate * 8;
+
+	// The simulation seeds the random numbers with the time on its first call
+	SimulationChannelDescriptor* simulation = 0;
+	analyzer.GenerateSimulationData( 0, analyzer.mTestSampleRate, &simulation );
+	srand( seed );
+	analyzer.GenerateSimulationData( samples, analyzer.mTestSampleRate, &simulation );
+
+	vector<U64> transitions;
+	for( size_t i = 0; i < simulation->mTransitions.size(); ++i )
+	{
+		if( dropEdges == 0 || i % dropEdges != dropEdges / 2 )
+		{
+			transitions.push_back( simulation->mTransitions[ i ] );
+		}
+	}
+
+	AnalyzerChannelData data( simulation->GetInitialBitState(), transitions, simulation->GetCurrentSampleNumber() );
+	analyzer.mTestChannelData = &data;
+	try
+	{
+		analyzer.WorkerThread();
+	}
+	catch( AnalyzerEndOfData& )
+	{
+	}
+
+	AnalyzerResults* results = analyzer.mTestResults;
+	if( results->mCommittedFrames != results->GetNumFrames() )
+	{
+		printf( "FAILED: mode %d decoder %d fcs %d, every %u edges dropped, %llu samples, seed %u: %llu of %llu fields committed\n", 
+				mode, decoder, fcs, dropEdges, samples, seed, results->mCommittedFrames, results->GetNumFrames() );
+		return false;
+	}
+	return true;
+}
+
+int main( int argc, char* argv[] )
+{
+	const HdlcBitSyncDecoderType decoders[] = { HDLC_BIT_SYNC_DECODER_SAMPLING, HDLC_BIT_SYNC_DECODER_EDGES, HDLC_BIT_SYNC_DECODER_DPLL };
+	const HdlcFcsType fcsTypes[] = { HDLC_CRC8, HDLC_CRC16, HDLC_CRC32 };
+	const U32 dropEdges[] = { 0, 3, 7, 13, 997 };
+
+	U32 tests = 0;
+	U32 failures = 0;
+	for( U32 seed = 1; seed <= 4; ++seed )
+	{
+		for( U32 f = 0; f < 3; ++f )
+		{
+			for( U32 d = 0; d < 5; ++d )
+			{
+				// Captures of different lengths end in different places of the stream
+				U64 samples = 50000 + ( seed * 7919 + dropEdges[ d ] * 131 + f * 17 ) % 900000;
+				for( U32 m = 0; m < 4; ++m )
+				{
+					HdlcTransmissionModeType mode = ( m < 3 ) ? HDLC_TRANSMISSION_BIT_SYNC : HDLC_TRANSMISSION_BYTE_ASYNC;
+					HdlcBitSyncDecoderType decoder = decoders[ ( m < 3 ) ? m : 0 ];
+					tests++;
+					if( !DecodeCapture( mode, decoder, fcsTypes[ f ], dropEdges[ d ], samples, seed ) )
+					{
+						failures++;
+					}
+				}
+			}
+		}
+	}
+
+	printf( "%u of %u captures committed\n", tests - failures, tests );
+	return ( failures == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+// Throughput of the CRC16 and CRC32 backends for several buffer sizes: the byte-wise table, the
+// slicing-by-8 tables and HdlcCrc::Crc16/Crc32, which use the carry-less multiplication folding
+// from HDLC_CRC_CLMUL_MIN_BYTES bytes when the CPU supports it. The CRCs of the backends are
+// checked against each other (the exit code tells a mismatch).
+//
+// The frame decoder of the analyzer reads a byte at a time from the channel and updates the FCS
+// with the byte-wise table of the model, so it doesn't use the folding; the simulation data
+// generator and the bit error location compute the CRC of whole buffers with HdlcCrc::Update.
+//
+// Build and run from the repository root with the stand-in SDK:
+//   g++ -std=c++03 -O2 -Itest/sdk -Isource source/HdlcCrc.cpp test/HdlcCrcBenchmark.cpp -o HdlcCrcBenchmark
+//   ./HdlcCrcBenchmark
+#include "HdlcCrc.h"
+#include "HdlcCrcModel.h"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+using namespace std;
+
+// Bytes processed per measure, whatever the buffer size
+#define HDLC_BENCHMARK_BYTES ( 64 * 1024 * 1024 )
+
+enum CrcBackend { BACKEND_BYTE_TABLE = 0, BACKEND_SLICING_BY_8, BACKEND_DISPATCH, BACKEND_COUNT };
+
+static const char* const gBackendNames[ BACKEND_COUNT ] = { "byte table", "slicing-by-8", "HdlcCrc" };
+
+template< typename Engine >
+static U32 EngineCrc( CrcBackend backend, const U8* data, U64 length, U32 crc )
+{
+	if( backend == BACKEND_BYTE_TABLE )
+	{
+		for( U64 i = 0; i < length; ++i )
+		{
+			crc = Engine::UpdateByte( crc, data[ i ] );
+		}
+		return crc;
+	}
+	return Engine::Update( crc, data, length );
+}
+
+// CRC16 or CRC32 (ISO/IEC 13239) of the buffer, crc is the CRC of the previous bytes
+static U32 Crc( HdlcFcsType fcsType, CrcBackend backend, const U8* data, U64 length, U32 crc )
+{
+	if( backend == BACKEND_DISPATCH )
+	{
+		return ( fcsType == HDLC_CRC16 ) ? HdlcCrc::Crc16( data, length, crc ) : HdlcCrc::Crc32( data, length, crc );
+	}
+	return ( fcsType == HDLC_CRC16 ) ? EngineCrc< HdlcCrc16Engine >( backend, data, length, crc ) 
+									 : EngineCrc< HdlcCrc32Engine >( backend, data, length, crc );
+}
+
+int main( int argc, char* argv[] )
+{
+	const U64 sizes[] = { 16, 64, 256, 4096, 65536, 1024 * 1024 };
+	const U32 sizeCount = sizeof( sizes ) / sizeof( sizes[ 0 ] );
+	const HdlcFcsType fcsTypes[] = { HDLC_CRC16, HDLC_CRC32 };
+
+	vector<U8> buffer( sizes[ sizeCount - 1 ] );
+	srand( 13239 );
+	for( size_t i = 0; i < buffer.size(); ++i )
+	{
+		buffer[ i ] = U8( rand() );
+	}
+
+	U32 mismatches = 0;
+	for( U32 f = 0; f < 2; ++f )
+	{
+		printf( "%s\n", ( fcsTypes[ f ] == HDLC_CRC16 ) ? "CRC16" : "CRC32" );
+		for( U32 s = 0; s < sizeCount; ++s )
+		{
+			printf( "  %8llu bytes:", sizes[ s ] );
+			U32 expected = Crc( fcsTypes[ f ], BACKEND_BYTE_TABLE, &buffer[ 0 ], sizes[ s ], 0 );
+			for( U32 b = 0; b < BACKEND_COUNT; ++b )
+			{
+				CrcBackend backend = CrcBackend( b );
+				U32 crc = Crc( fcsTypes[ f ], backend, &buffer[ 0 ], sizes[ s ], 0 );
+				if( crc != expected )
+				{
+					mismatches++;
+					printf( " %s: CRC 0x%08X instead of 0x%08X", gBackendNames[ b ], crc, expected );
+					continue;
+				}
+
+				// The buffer is processed again and again as one stream, so no call can be left out
+				U64 repeats = HDLC_BENCHMARK_BYTES / sizes[ s ];
+				crc = 0;
+				clock_t start = clock();
+				for( U64 r = 0; r < repeats; ++r )
+				{
+					crc = Crc( fcsTypes[ f ], backend, &buffer[ 0 ], sizes[ s ], crc );
+				}
+				double seconds = double( clock() - start ) / CLOCKS_PER_SEC;
+				double megabytes = double( repeats * sizes[ s ] ) / ( 1024.0 * 1024.0 );
+				printf( "  %s %.0f MB/s", gBackendNames[ b ], ( seconds > 0 ) ? megabytes / seconds : 0.0 );
+			}
+			printf( "\n" );
+		}
+	}
+
+	return ( mismatches == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,44 @@
+#ifndef ANALYZER
+#define ANALYZER
+
+#include "LogicPublicTypes.h"
+#include "AnalyzerTypes.h"
+#include "AnalyzerResults.h"
+#include "AnalyzerSettings.h"
+#include "AnalyzerChannelData.h"
+#include "SimulationChannelDescriptor.h"
+
+// Stand-in for the analyzer of the Saleae Analyzer SDK (see test/sdk/AnalyzerSdk.cpp). There is no
+// thread: a test sets the capture and the sample rate and calls WorkerThread() itself.
+class Analyzer
+{
+public:
+	Analyzer();
+	virtual ~Analyzer();
+
+	virtual void WorkerThread() = 0;
+	virtual U32 GenerateSimulationData( U64 newest_sample_requested, U32 sample_rate, SimulationChannelDescriptor** simulation_channels ) = 0;
+	virtual U32 GetMinimumSampleRateHz() = 0;
+	virtual const char* GetAnalyzerName() const = 0;
+	virtual bool NeedsRerun() = 0;
+
+	void SetAnalyzerSettings( AnalyzerSettings* settings ) { mTestSettings = settings; }
+	void SetAnalyzerResults( AnalyzerResults* results );
+	AnalyzerChannelData* GetAnalyzerChannelData( Channel& channel ) { return mTestChannelData; }
+	U32 GetSimulationSampleRate() { return mTestSampleRate; }
+	U32 GetSampleRate() { return mTestSampleRate; }
+	U64 GetTriggerSample() { return 0; }
+	void ReportProgress( U64 sample_number ) {}
+	void CheckIfThreadShouldExit() {}
+	void KillThread() {}
+
+	AnalyzerSettings* mTestSettings;
+	AnalyzerResults* mTestResults;
+	AnalyzerChannelData* mTestChannelData;
+	U32 mTestSampleRate;
+	// Frames and markers the results are made room for, as the storage of the SDK is not the
+	// analyzer's (for a test that counts the allocations of the analyzer)
+	U64 mTestReservedResults;
+};
+
+#endif
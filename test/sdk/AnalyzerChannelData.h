@@ -0,0 +1,43 @@
+#ifndef ANALYZER_CHANNEL_DATA
+#define ANALYZER_CHANNEL_DATA
+
+#include "LogicPublicTypes.h"
+#include <vector>
+
+// Thrown by the stand-in channel data when a read needs samples past the end of the capture.
+// The SDK blocks there until the capture goes on (or the thread is killed): a test catches it
+// where the analyzer would wait.
+struct AnalyzerEndOfData {};
+
+// Stand-in for the channel data of the Saleae Analyzer SDK: the transitions of a capture of
+// endSample samples. The channel calls are counted.
+class AnalyzerChannelData
+{
+public:
+	AnalyzerChannelData( BitState initialBitState, const std::vector<U64>& transitions, U64 endSample );
+
+	U64 GetSampleNumber();
+	BitState GetBitState();
+	U32 Advance( U32 num_samples );
+	U32 AdvanceToAbsPosition( U64 sample_number );
+	void AdvanceToNextEdge();
+	U64 GetSampleOfNextEdge();
+	bool WouldAdvancingCauseTransition( U32 num_samples );
+	bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number );
+	void TrackMinimumPulseWidth() {}
+	U64 GetMinimumPulseWidthSoFar() { return 0; }
+	bool DoMoreTransitionsExistInCurrentData();
+
+	U64 mCalls;
+
+protected:
+	void CheckSample( U64 sample );
+
+	BitState mInitialBitState;
+	const std::vector<U64>* mTransitions;
+	U64 mEndSample;
+	U64 mSample;
+	U64 mNextTransition;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef ANALYZER_HELPERS_H
+#define ANALYZER_HELPERS_H
+
+#include "Analyzer.h"
+#include <string>
+
+// Stand-in for the helpers of the Saleae Analyzer SDK (see test/sdk/AnalyzerSdk.cpp)
+
+class AnalyzerHelpers
+{
+public:
+	static void GetNumberString( U64 number, DisplayBase display_base, U32 num_data_bits, char* result_string, U32 result_string_max_length );
+	static void GetTimeString( U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32 result_string_max_length );
+	static U64 AdjustSimulationTargetSample( U64 target_sample, U32 sample_rate, U32 simulation_sample_rate );
+};
+
+class BitExtractor
+{
+public:
+	BitExtractor( U64 data, AnalyzerEnums::ShiftOrder shift_order, U32 num_bits )
+	:	mData( data ), mShiftOrder( shift_order ), mNumBits( num_bits ), mIndex( 0 ) {}
+
+	BitState GetNextBit()
+	{
+		U32 bit = ( mShiftOrder == AnalyzerEnums::LsbFirst ) ? mIndex : ( mNumBits - 1 - mIndex );
+		mIndex++;
+		return ( ( mData >> bit ) & 1 ) ? BIT_HIGH : BIT_LOW;
+	}
+
+protected:
+	U64 mData;
+	AnalyzerEnums::ShiftOrder mShiftOrder;
+	U32 mNumBits;
+	U32 mIndex;
+};
+
+class DataBuilder
+{
+public:
+	DataBuilder() : mData( 0 ), mShiftOrder( AnalyzerEnums::MsbFirst ), mNumBits( 0 ), mIndex( 0 ) {}
+
+	void Reset( U64* data, AnalyzerEnums::ShiftOrder shift_order, U32 num_bits )
+	{
+		mData = data;
+		mShiftOrder = shift_order;
+		mNumBits = num_bits;
+		mIndex = 0;
+		*mData = 0;
+	}
+	void AddBit( BitState bit )
+	{
+		if( mShiftOrder == AnalyzerEnums::LsbFirst )
+		{
+			if( bit == BIT_HIGH )
+			{
+				*mData |= 1ull << mIndex;
+			}
+		}
+		else
+		{
+			*mData <<= 1;
+			if( bit == BIT_HIGH )
+			{
+				*mData |= 1;
+			}
+		}
+		mIndex++;
+	}
+
+protected:
+	U64* mData;
+	AnalyzerEnums::ShiftOrder mShiftOrder;
+	U32 mNumBits;
+	U32 mIndex;
+};
+
+// The values are written as text separated by spaces
+class SimpleArchive
+{
+public:
+	SimpleArchive();
+	~SimpleArchive();
+
+	void SetString( const char* archive_string );
+	const char* GetString();
+
+	bool operator<<( U64 data );
+	bool operator<<( U32 data );
+	bool operator<<( S64 data );
+	bool operator<<( S32 data );
+	bool operator<<( double data );
+	bool operator<<( bool data );
+	bool operator<<( const char* data );
+	bool operator<<( Channel& data );
+
+	bool operator>>( U64& data );
+	bool operator>>( U32& data );
+	bool operator>>( S64& data );
+	bool operator>>( S32& data );
+	bool operator>>( double& data );
+	bool operator>>( bool& data );
+	bool operator>>( char const** data );
+	bool operator>>( Channel& data );
+
+protected:
+	bool NextToken( std::string& token );
+
+	std::string mOutput;
+	std::string mInput;
+	size_t mPosition;
+	std::string mString;
+};
+
+#endif
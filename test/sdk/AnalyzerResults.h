@@ -0,0 +1,69 @@
+#ifndef ANALYZER_RESULTS
+#define ANALYZER_RESULTS
+
+#include "LogicPublicTypes.h"
+#include "AnalyzerTypes.h"
+#include <string>
+#include <vector>
+
+// Stand-in for the results of the Saleae Analyzer SDK (see test/sdk/AnalyzerSdk.cpp): the frames
+// are kept in a vector, with the number of them committed so far.
+
+#define DISPLAY_AS_ERROR_FLAG ( 1 << 7 )
+#define DISPLAY_AS_WARNING_FLAG ( 1 << 6 )
+#define INVALID_RESULT_INDEX 0xFFFFFFFFFFFFFFFFull
+
+class Frame
+{
+public:
+	Frame() : mStartingSampleInclusive( 0 ), mEndingSampleInclusive( 0 ), mData1( 0 ), mData2( 0 ), mType( 0 ), mFlags( 0 ) {}
+
+	bool HasFlag( U8 flag ) { return ( mFlags & flag ) != 0; }
+
+	S64 mStartingSampleInclusive;
+	S64 mEndingSampleInclusive;
+	U64 mData1;
+	U64 mData2;
+	U8 mType;
+	U8 mFlags;
+};
+
+class AnalyzerResults
+{
+public:
+	enum MarkerType { Dot, ErrorDot, Square, ErrorSquare, UpArrow, DownArrow, X, ErrorX, Start, Stop, One, Zero };
+
+	AnalyzerResults();
+	virtual ~AnalyzerResults();
+
+	virtual void GenerateBubbleText( U64 frame_index, Channel& channel, DisplayBase display_base ) = 0;
+	virtual void GenerateExportFile( const char* file, DisplayBase display_base, U32 export_type_user_id ) = 0;
+	virtual void GenerateFrameTabularText( U64 frame_index, DisplayBase display_base ) = 0;
+	virtual void GeneratePacketTabularText( U64 packet_id, DisplayBase display_base ) = 0;
+	virtual void GenerateTransactionTabularText( U64 transaction_id, DisplayBase display_base ) = 0;
+
+	void AddMarker( U64 sample_number, MarkerType marker_type, Channel& channel );
+	U64 AddFrame( const Frame& frame );
+	U64 CommitPacketAndStartNewPacket() { return 0; }
+	void CancelPacketAndStartNewPacket() {}
+	void AddPacketToTransaction( U64 transaction_id, U64 packet_id ) {}
+	void AddChannelBubblesWillAppearOn( const Channel& channel ) {}
+	void CommitResults();
+
+	U64 GetNumFrames() { return mFrames.size(); }
+	U64 GetNumPackets() { return 0; }
+	Frame GetFrame( U64 frame_id ) { return mFrames.at( frame_id ); }
+
+	void ClearResultStrings() { mResultStrings.clear(); }
+	void AddResultString( const char* str1, const char* str2 = NULL, const char* str3 = NULL, const char* str4 = NULL, 
+						  const char* str5 = NULL, const char* str6 = NULL );
+	bool UpdateExportProgressAndCheckForCancel( U64 completed_frames, U64 total_frames ) { return false; }
+
+	std::vector<Frame> mFrames;
+	std::vector<U64> mMarkers;
+	std::vector<std::string> mResultStrings;
+	U64 mCommittedFrames;
+	U64 mCommits;
+};
+
+#endif
@@ -0,0 +1,310 @@
+// Stand-in for the Saleae Analyzer SDK library, to build and run the tests of the analyzer without
+// the SDK and the Logic application. Only what the analyzer uses is there; the channel data of a
+// capture is a vector of transitions, and the results keep the frames in memory.
+#include <Analyzer.h>
+#include <AnalyzerHelpers.h>
+#include <AnalyzerChannelData.h>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+Analyzer::Analyzer()
+:	mTestSettings( 0 ),
+	mTestResults( 0 ),
+	mTestChannelData( 0 ),
+	mTestSampleRate( 0 ),
+	mTestReservedResults( 0 )
+{
+}
+
+Analyzer::~Analyzer()
+{
+}
+
+void Analyzer::SetAnalyzerResults( AnalyzerResults* results )
+{
+	mTestResults = results;
+	mTestResults->mFrames.reserve( mTestReservedResults );
+	mTestResults->mMarkers.reserve( mTestReservedResults );
+}
+
+AnalyzerChannelData::AnalyzerChannelData( BitState initialBitState, const std::vector<U64>& transitions, U64 endSample )
+:	mCalls( 0 ),
+	mInitialBitState( initialBitState ),
+	mTransitions( &transitions ),
+	mEndSample( endSample ),
+	mSample( 0 ),
+	mNextTransition( 0 )
+{
+	while( mNextTransition < mTransitions->size() && ( *mTransitions )[ mNextTransition ] == 0 )
+	{
+		mNextTransition++;
+	}
+}
+
+// The SDK waits for the capture to reach the sample
+void AnalyzerChannelData::CheckSample( U64 sample )
+{
+	if( sample > mEndSample )
+	{
+		throw AnalyzerEndOfData();
+	}
+}
+
+U64 AnalyzerChannelData::GetSampleNumber()
+{
+	mCalls++;
+	return mSample;
+}
+
+BitState AnalyzerChannelData::GetBitState()
+{
+	mCalls++;
+	return ( mNextTransition & 1 ) ? Toggle( mInitialBitState ) : mInitialBitState;
+}
+
+U32 AnalyzerChannelData::Advance( U32 num_samples )
+{
+	mCalls++;
+	CheckSample( mSample + num_samples );
+	U32 transitions = 0;
+	while( mNextTransition < mTransitions->size() && ( *mTransitions )[ mNextTransition ] <= mSample + num_samples )
+	{
+		mNextTransition++;
+		transitions++;
+	}
+	mSample += num_samples;
+	return transitions;
+}
+
+U32 AnalyzerChannelData::AdvanceToAbsPosition( U64 sample_number )
+{
+	return Advance( U32( sample_number - mSample ) );
+}
+
+void AnalyzerChannelData::AdvanceToNextEdge()
+{
+	U64 edge = GetSampleOfNextEdge();
+	AdvanceToAbsPosition( edge );
+	mCalls--;
+}
+
+U64 AnalyzerChannelData::GetSampleOfNextEdge()
+{
+	mCalls++;
+	if( mNextTransition >= mTransitions->size() )
+	{
+		throw AnalyzerEndOfData();
+	}
+	CheckSample( ( *mTransitions )[ mNextTransition ] );
+	return ( *mTransitions )[ mNextTransition ];
+}
+
+bool AnalyzerChannelData::WouldAdvancingCauseTransition( U32 num_samples )
+{
+	return WouldAdvancingToAbsPositionCauseTransition( mSample + num_samples );
+}
+
+bool AnalyzerChannelData::WouldAdvancingToAbsPositionCauseTransition( U64 sample_number )
+{
+	mCalls++;
+	CheckSample( sample_number );
+	return mNextTransition < mTransitions->size() && ( *mTransitions )[ mNextTransition ] <= sample_number;
+}
+
+bool AnalyzerChannelData::DoMoreTransitionsExistInCurrentData()
+{
+	mCalls++;
+	return mNextTransition < mTransitions->size() && ( *mTransitions )[ mNextTransition ] <= mEndSample;
+}
+
+AnalyzerResults::AnalyzerResults()
+:	mCommittedFrames( 0 ),
+	mCommits( 0 )
+{
+}
+
+AnalyzerResults::~AnalyzerResults()
+{
+}
+
+void AnalyzerResults::AddMarker( U64 sample_number, MarkerType marker_type, Channel& channel )
+{
+	mMarkers.push_back( sample_number );
+}
+
+U64 AnalyzerResults::AddFrame( const Frame& frame )
+{
+	mFrames.push_back( frame );
+	return mFrames.size() - 1;
+}
+
+void AnalyzerResults::CommitResults()
+{
+	mCommittedFrames = mFrames.size();
+	mCommits++;
+}
+
+void AnalyzerResults::AddResultString( const char* str1, const char* str2, const char* str3, const char* str4, 
+									   const char* str5, const char* str6 )
+{
+	std::string str( str1 );
+	const char* more[] = { str2, str3, str4, str5, str6 };
+	for( U32 i = 0; i < 5 && more[ i ] != NULL; ++i )
+	{
+		str += more[ i ];
+	}
+	mResultStrings.push_back( str );
+}
+
+void AnalyzerHelpers::GetNumberString( U64 number, DisplayBase display_base, U32 num_data_bits, char* result_string, U32 result_string_max_length )
+{
+	if( display_base == Decimal )
+	{
+		snprintf( result_string, result_string_max_length, "%llu", number );
+	}
+	else
+	{
+		snprintf( result_string, result_string_max_length, "0x%0*llX", int( ( num_data_bits + 3 ) / 4 ), number );
+	}
+}
+
+void AnalyzerHelpers::GetTimeString( U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32 result_string_max_length )
+{
+	snprintf( result_string, result_string_max_length, "%.9f", double( S64( sample - trigger_sample ) ) / double( sample_rate_hz ) );
+}
+
+U64 AnalyzerHelpers::AdjustSimulationTargetSample( U64 target_sample, U32 sample_rate, U32 simulation_sample_rate )
+{
+	return U64( double( target_sample ) * double( simulation_sample_rate ) / double( sample_rate ) );
+}
+
+SimpleArchive::SimpleArchive()
+:	mPosition( 0 )
+{
+}
+
+SimpleArchive::~SimpleArchive()
+{
+}
+
+void SimpleArchive::SetString( const char* archive_string )
+{
+	mInput = archive_string;
+	mPosition = 0;
+}
+
+const char* SimpleArchive::GetString()
+{
+	return mOutput.c_str();
+}
+
+bool SimpleArchive::NextToken( std::string& token )
+{
+	while( mPosition < mInput.size() && mInput[ mPosition ] == ' ' )
+	{
+		mPosition++;
+	}
+	if( mPosition >= mInput.size() )
+	{
+		return false;
+	}
+	size_t end = mInput.find( ' ', mPosition );
+	if( end == std::string::npos )
+	{
+		end = mInput.size();
+	}
+	token = mInput.substr( mPosition, end - mPosition );
+	mPosition = end;
+	return true;
+}
+
+template< typename T >
+static bool WriteValue( std::string& output, T data )
+{
+	std::ostringstream stream;
+	stream << data << ' ';
+	output += stream.str();
+	return true;
+}
+
+template< typename T >
+static bool ReadValue( const std::string& token, T& data )
+{
+	std::istringstream stream( token );
+	stream >> data;
+	return !stream.fail();
+}
+
+bool SimpleArchive::operator<<( U64 data ) { return WriteValue( mOutput, data ); }
+bool SimpleArchive::operator<<( U32 data ) { return WriteValue( mOutput, data ); }
+bool SimpleArchive::operator<<( S64 data ) { return WriteValue( mOutput, data ); }
+bool SimpleArchive::operator<<( S32 data ) { return WriteValue( mOutput, data ); }
+bool SimpleArchive::operator<<( double data ) { return WriteValue( mOutput, data ); }
+bool SimpleArchive::operator<<( bool data ) { return WriteValue( mOutput, data ? 1 : 0 ); }
+
+// Strings are written with their spaces as \x02, and an empty one as \x01
+bool SimpleArchive::operator<<( const char* data )
+{
+	std::string str( data );
+	if( str.empty() )
+	{
+		str = "\x01";
+	}
+	for( size_t i = 0; i < str.size(); ++i )
+	{
+		if( str[ i ] == ' ' )
+		{
+			str[ i ] = '\x02';
+		}
+	}
+	return WriteValue( mOutput, str );
+}
+
+bool SimpleArchive::operator<<( Channel& data )
+{
+	return WriteValue( mOutput, data.mDeviceId ) && WriteValue( mOutput, data.mChannelIndex );
+}
+
+bool SimpleArchive::operator>>( U64& data ) { std::string token; return NextToken( token ) && ReadValue( token, data ); }
+bool SimpleArchive::operator>>( U32& data ) { std::string token; return NextToken( token ) && ReadValue( token, data ); }
+bool SimpleArchive::operator>>( S64& data ) { std::string token; return NextToken( token ) && ReadValue( token, data ); }
+bool SimpleArchive::operator>>( S32& data ) { std::string token; return NextToken( token ) && ReadValue( token, data ); }
+bool SimpleArchive::operator>>( double& data ) { std::string token; return NextToken( token ) && ReadValue( token, data ); }
+
+bool SimpleArchive::operator>>( bool& data )
+{
+	std::string token;
+	if( !NextToken( token ) )
+	{
+		return false;
+	}
+	data = ( token == "1" );
+	return true;
+}
+
+bool SimpleArchive::operator>>( char const** data )
+{
+	if( !NextToken( mString ) )
+	{
+		return false;
+	}
+	if( mString == "\x01" )
+	{
+		mString.clear();
+	}
+	for( size_t i = 0; i < mString.size(); ++i )
+	{
+		if( mString[ i ] == '\x02' )
+		{
+			mString[ i ] = ' ';
+		}
+	}
+	*data = mString.c_str();
+	return true;
+}
+
+bool SimpleArchive::operator>>( Channel& data )
+{
+	return ( *this >> data.mDeviceId ) && ( *this >> data.mChannelIndex );
+}
@@ -0,0 +1,94 @@
+#ifndef ANALYZER_SETTING_INTERFACE
+#define ANALYZER_SETTING_INTERFACE
+
+#include "AnalyzerTypes.h"
+#include <string>
+#include <vector>
+
+// Stand-in for the setting interfaces of the Saleae Analyzer SDK (see test/sdk/AnalyzerSdk.cpp)
+
+class AnalyzerSettingInterface
+{
+public:
+	virtual ~AnalyzerSettingInterface() {}
+	void SetTitleAndTooltip( const char* title, const char* tooltip ) { mTitle = title; mTooltip = tooltip; }
+
+	std::string mTitle;
+	std::string mTooltip;
+};
+
+class AnalyzerSettingInterfaceChannel : public AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterfaceChannel() : mSelectionOfNoneIsAllowed( false ) {}
+	Channel GetChannel() { return mChannel; }
+	void SetChannel( const Channel& channel ) { mChannel = channel; }
+	bool GetSelectionOfNoneIsAllowed() { return mSelectionOfNoneIsAllowed; }
+	void SetSelectionOfNoneIsAllowed( bool is_allowed ) { mSelectionOfNoneIsAllowed = is_allowed; }
+
+	Channel mChannel;
+	bool mSelectionOfNoneIsAllowed;
+};
+
+class AnalyzerSettingInterfaceNumberList : public AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterfaceNumberList() : mNumber( 0 ) {}
+	double GetNumber() { return mNumber; }
+	void SetNumber( double number ) { mNumber = number; }
+	void AddNumber( double number, const char* str, const char* tooltip )
+	{
+		mNumbers.push_back( number );
+		mStrings.push_back( str );
+		mTooltips.push_back( tooltip );
+	}
+	void ClearNumbers() { mNumbers.clear(); mStrings.clear(); mTooltips.clear(); }
+
+	double mNumber;
+	std::vector<double> mNumbers;
+	std::vector<std::string> mStrings;
+	std::vector<std::string> mTooltips;
+};
+
+class AnalyzerSettingInterfaceInteger : public AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterfaceInteger() : mInteger( 0 ), mMax( 0 ), mMin( 0 ) {}
+	int GetInteger() { return mInteger; }
+	void SetInteger( int integer ) { mInteger = integer; }
+	void SetMax( int max ) { mMax = max; }
+	void SetMin( int min ) { mMin = min; }
+
+	int mInteger;
+	int mMax;
+	int mMin;
+};
+
+class AnalyzerSettingInterfaceText : public AnalyzerSettingInterface
+{
+public:
+	enum TextType { NormalText, FilePath, FolderPath };
+
+	AnalyzerSettingInterfaceText() : mTextType( NormalText ) {}
+	const char* GetText() { return mText.c_str(); }
+	void SetText( const char* text ) { mText = text; }
+	void SetTextType( TextType text_type ) { mTextType = text_type; }
+
+	std::string mText;
+	TextType mTextType;
+};
+
+class AnalyzerSettingInterfaceBool : public AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterfaceBool() : mValue( false ) {}
+	bool GetValue() { return mValue; }
+	void SetValue( bool value ) { mValue = value; }
+	const char* GetCheckBoxText() { return mCheckBoxText.c_str(); }
+	void SetCheckBoxText( const char* text ) { mCheckBoxText = text; }
+
+	bool mValue;
+	std::string mCheckBoxText;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef ANALYZER_TYPES
+#define ANALYZER_TYPES
+
+#include "LogicPublicTypes.h"
+
+// Stand-in for the header of the Saleae Analyzer SDK (see test/sdk/AnalyzerSdk.cpp)
+
+namespace AnalyzerEnums
+{
+	enum ShiftOrder { MsbFirst, LsbFirst };
+	enum EdgeDirection { PosEdge, NegEdge };
+	enum Edge { LeadingEdge, TrailingEdge };
+	enum Parity { None, Even, Odd };
+	enum Acknowledge { Ack, Nak };
+	enum Sign { UnsignedInteger, SignedInteger };
+}
+
+enum ChannelDataType { ANALOG, DIGITAL };
+
+class Channel
+{
+public:
+	Channel() : mDeviceId( 0 ), mChannelIndex( 0xFFFFFFFF ), mDataType( DIGITAL ) {}
+	Channel( U64 device_id, U32 channel_index, ChannelDataType data_type )
+	:	mDeviceId( device_id ), mChannelIndex( channel_index ), mDataType( data_type ) {}
+
+	bool operator==( const Channel& channel ) const
+	{
+		return mDeviceId == channel.mDeviceId && mChannelIndex == channel.mChannelIndex;
+	}
+	bool operator!=( const Channel& channel ) const { return !( *this == channel ); }
+
+	U64 mDeviceId;
+	U32 mChannelIndex;
+	ChannelDataType mDataType;
+};
+
+#define UNDEFINED_CHANNEL Channel( 0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFF, DIGITAL )
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef LOGIC_PUBLIC_TYPES
+#define LOGIC_PUBLIC_TYPES
+
+// Stand-in for the header of the Saleae Analyzer SDK: only what the analyzer uses, to build the
+// tests without the SDK library (see test/sdk/AnalyzerSdk.cpp)
+
+#define ANALYZER_EXPORT
+#ifndef __cdecl
+#define __cdecl
+#endif
+
+typedef signed char S8;
+typedef short S16;
+typedef int S32;
+typedef long long S64;
+typedef unsigned char U8;
+typedef unsigned short U16;
+typedef unsigned int U32;
+typedef unsigned long long U64;
+
+enum DisplayBase { Binary, Decimal, Hexadecimal, ASCII, AsciiHex };
+enum BitState { BIT_LOW, BIT_HIGH };
+
+#define Toggle( x ) ( x == BIT_LOW ? BIT_HIGH : BIT_LOW )
+#define Invert( x ) ( x == BIT_LOW ? BIT_HIGH : BIT_LOW )
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef SIMULATION_CHANNEL_DESCRIPTOR
+#define SIMULATION_CHANNEL_DESCRIPTOR
+
+#include "AnalyzerTypes.h"
+#include <vector>
+
+// Stand-in for the simulation channel of the Saleae Analyzer SDK (see test/sdk/AnalyzerSdk.cpp):
+// the transitions are kept to be decoded as a capture.
+class SimulationChannelDescriptor
+{
+public:
+	SimulationChannelDescriptor() : mSample( 0 ), mInitialBitState( BIT_LOW ), mBitState( BIT_LOW ), mSampleRate( 0 ) {}
+
+	void Transition()
+	{
+		mTransitions.push_back( mSample );
+		mBitState = Toggle( mBitState );
+	}
+	void TransitionIfNeeded( BitState bit_state )
+	{
+		if( bit_state != mBitState )
+		{
+			Transition();
+		}
+	}
+	void Advance( U32 num_samples_to_advance ) { mSample += num_samples_to_advance; }
+	BitState GetCurrentBitState() { return mBitState; }
+	U64 GetCurrentSampleNumber() { return mSample; }
+
+	void SetChannel( Channel& channel ) { mChannel = channel; }
+	void SetSampleRate( U32 sample_rate_hz ) { mSampleRate = sample_rate_hz; }
+	void SetInitialBitState( BitState initial_bit_state ) { mInitialBitState = mBitState = initial_bit_state; }
+	Channel GetChannel() { return mChannel; }
+	U32 GetSampleRate() { return mSampleRate; }
+	BitState GetInitialBitState() { return mInitialBitState; }
+
+	std::vector<U64> mTransitions;
+	U64 mSample;
+	BitState mInitialBitState;
+	BitState mBitState;
+	U32 mSampleRate;
+	Channel mChannel;
+};
+
+#endif